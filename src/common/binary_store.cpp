@@ -0,0 +1,101 @@
+#include "binary_store.hpp"
+#include <algorithm>
+#include <bit>
+#include <queue>
+#include <stdexcept>
+
+namespace atlas {
+
+BinaryStore::BinaryStore(const VectorStore& store)
+    : store_(store), words_((store.getDimension() + 63) / 64) {
+    sync();
+}
+
+void BinaryStore::encode(VectorView vec, uint64_t* out) {
+    size_t words = (vec.size() + 63) / 64;
+    std::fill(out, out + words, 0);
+    for (size_t i = 0; i < vec.size(); i++) {
+        if (vec[i] > 0.0f) {
+            out[i / 64] |= uint64_t(1) << (i % 64);
+        }
+    }
+}
+
+void BinaryStore::addVector(VectorId id) {
+    if (rows_.count(id)) {
+        throw std::invalid_argument("Vector already encoded: " + std::to_string(id));
+    }
+    VectorView vec = store_.getVector(id);
+
+    rows_.emplace(id, ids_.size());
+    ids_.push_back(id);
+    codes_.resize(codes_.size() + words_);
+    encode(vec, codes_.data() + codes_.size() - words_);
+}
+
+void BinaryStore::sync() {
+    for (VectorId id : store_.ids()) {
+        if (!rows_.count(id)) {
+            addVector(id);
+        }
+    }
+}
+
+void BinaryStore::validateQuery(const Vector& query) const {
+    if (query.size() != store_.getDimension()) {
+        throw std::invalid_argument("Query dimension mismatch: expected " +
+                                    std::to_string(store_.getDimension()) + ", got " +
+                                    std::to_string(query.size()));
+    }
+}
+
+std::vector<VectorWithDistance> BinaryStore::hammingSearch(const Vector& query,
+                                                           size_t n) const {
+    validateQuery(query);
+    if (n == 0 || ids_.empty()) {
+        return {};
+    }
+
+    std::vector<uint64_t> queryCode(words_);
+    encode(query, queryCode.data());
+
+    // bounded max-heap of the n smallest Hamming distances
+    std::priority_queue<std::pair<uint32_t, VectorId>> best;
+    const uint64_t* code = codes_.data();
+    for (size_t row = 0; row < ids_.size(); row++, code += words_) {
+        uint32_t distance = 0;
+        for (size_t w = 0; w < words_; w++) {
+            distance += std::popcount(code[w] ^ queryCode[w]);
+        }
+        if (best.size() < n) {
+            best.push({distance, ids_[row]});
+        } else if (distance < best.top().first) {
+            best.pop();
+            best.push({distance, ids_[row]});
+        }
+    }
+
+    std::vector<VectorWithDistance> results(best.size());
+    for (size_t i = results.size(); i-- > 0;) {
+        results[i] = {best.top().second, static_cast<Distance>(best.top().first)};
+        best.pop();
+    }
+    return results;
+}
+
+std::vector<VectorWithDistance> BinaryStore::search(const Vector& query, size_t k,
+                                                    size_t overFetch) const {
+    auto candidates = hammingSearch(query, k * std::max<size_t>(overFetch, 1));
+
+    // exact re-rank on the fp32 vectors
+    for (auto& candidate : candidates) {
+        candidate.distance = store_.cosineDistance(query, store_.getVector(candidate.id));
+    }
+
+    size_t resultCount = std::min(k, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + resultCount, candidates.end());
+    candidates.resize(resultCount);
+    return candidates;
+}
+
+} // namespace atlas
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "types.hpp"
+#include "vector_store.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * BinaryStore - 1-bit (sign) quantized codes for the vectors of a VectorStore
+ *
+ * Each vector is reduced to one bit per dimension (1 if the component is
+ * positive), packed into 64-bit words, so a 1536-d float vector (6 KB)
+ * becomes a 192-byte code. Hamming distance between codes approximates
+ * angular distance and is computed with popcount. Search scans the codes,
+ * keeps the k * overFetch closest by Hamming distance and re-ranks those
+ * exactly with cosine distance on the fp32 vectors from the VectorStore.
+ */
+class BinaryStore {
+public:
+    /**
+     * Constructor: encodes every vector currently in the store
+     * @param store Source of fp32 vectors (must outlive this object)
+     */
+    explicit BinaryStore(const VectorStore& store);
+
+    /**
+     * Encode one vector that was added to the store
+     * @param id ID present in the store
+     * @throws std::invalid_argument if the ID is already encoded
+     * @throws std::out_of_range if the ID is not in the store
+     */
+    void addVector(VectorId id);
+
+    /**
+     * Encode every store vector that has no code yet
+     */
+    void sync();
+
+    /**
+     * Pack the sign bits of a vector into words
+     * @param vec Vector to encode
+     * @param out Destination, (vec.size() + 63) / 64 words
+     */
+    static void encode(VectorView vec, uint64_t* out);
+
+    /**
+     * Candidates closest in Hamming distance (no re-ranking)
+     * @param query Query vector
+     * @param n Number of candidates
+     * @return (id, Hamming distance as float) pairs, closest first
+     */
+    std::vector<VectorWithDistance> hammingSearch(const Vector& query, size_t n) const;
+
+    /**
+     * Hamming pre-filter followed by exact re-rank
+     * @param query Query vector
+     * @param k Number of results
+     * @param overFetch Candidates re-ranked per result (k * overFetch total)
+     * @return Top k by cosine distance among the candidates, closest first
+     */
+    std::vector<VectorWithDistance> search(const Vector& query, size_t k,
+                                           size_t overFetch = 4) const;
+
+    // Number of encoded vectors
+    size_t size() const { return ids_.size(); }
+
+    // 64-bit words per code
+    size_t wordsPerCode() const { return words_; }
+
+    // Bytes used by the codes (excluding ID bookkeeping)
+    size_t codeBytes() const { return codes_.size() * sizeof(uint64_t); }
+
+private:
+    void validateQuery(const Vector& query) const;
+
+    const VectorStore& store_;
+    size_t words_;                               // Words per code
+    std::vector<uint64_t> codes_;                // Packed codes, one row per vector
+    std::vector<VectorId> ids_;                  // Row -> ID
+    std::unordered_map<VectorId, size_t> rows_;  // ID -> row
+};
+
+} // namespace atlas
@@ -0,0 +1,162 @@
+#include "memory.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sched.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace atlas {
+
+namespace {
+
+constexpr size_t kHugePageSize = size_t(2) << 20;
+constexpr int kMpolInterleave = 3; // MPOL_INTERLEAVE from <linux/mempolicy.h>
+
+// Policy-backed allocations are whole huge pages so they can be huge-page mapped
+size_t roundToHugePage(size_t bytes) {
+    return (bytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+}
+
+bool usesMapping(size_t bytes, const MemoryPolicy& policy) {
+    return !policy.isDefault() && bytes >= kPolicyThreshold;
+}
+
+// Parse a sysfs cpu/node list such as "0-3,8,10-11"
+std::vector<int> parseList(const std::string& text) {
+    std::vector<int> values;
+    std::stringstream ss(text);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        size_t dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int v = first; v <= last; v++) {
+            values.push_back(v);
+        }
+    }
+    return values;
+}
+
+std::string readFirstLine(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    return line;
+}
+
+void interleave(void* addr, size_t bytes) {
+    std::vector<int> nodes = onlineNumaNodes();
+    if (nodes.size() < 2) {
+        return;
+    }
+    // mask of the online node IDs themselves: they need not be 0..n-1
+    // (e.g. "0,2"), and an offline node in the mask makes mbind fail
+    constexpr size_t kBitsPerWord = sizeof(unsigned long) * 8;
+    std::vector<unsigned long> mask(nodes.back() / kBitsPerWord + 1, 0);
+    for (int node : nodes) {
+        mask[node / kBitsPerWord] |= 1UL << (node % kBitsPerWord);
+    }
+    // Best-effort: on failure the kernel keeps first-touch placement
+    syscall(SYS_mbind, addr, bytes, kMpolInterleave, mask.data(),
+            mask.size() * kBitsPerWord + 1, 0);
+}
+
+} // namespace
+
+void* allocateWithPolicy(size_t bytes, const MemoryPolicy& policy) {
+    if (!usesMapping(bytes, policy)) {
+        return ::operator new(bytes);
+    }
+
+    size_t length = roundToHugePage(bytes);
+    void* addr = MAP_FAILED;
+
+    if (policy.hugePages == HugePageMode::Explicit) {
+        addr = ::mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+    if (addr == MAP_FAILED) {
+        addr = ::mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        if (policy.hugePages != HugePageMode::None) {
+            ::madvise(addr, length, MADV_HUGEPAGE);
+        }
+    }
+
+    // Placement must be set before the first touch to take effect
+    if (policy.numa == NumaMode::Interleave) {
+        interleave(addr, length);
+    }
+    return addr;
+}
+
+void deallocateWithPolicy(void* ptr, size_t bytes, const MemoryPolicy& policy) {
+    if (ptr == nullptr) {
+        return;
+    }
+    if (!usesMapping(bytes, policy)) {
+        ::operator delete(ptr);
+        return;
+    }
+    ::munmap(ptr, roundToHugePage(bytes));
+}
+
+std::vector<int> onlineNumaNodes() {
+    std::vector<int> nodes = parseList(readFirstLine("/sys/devices/system/node/online"));
+    if (nodes.empty()) {
+        // Kernels without NUMA sysfs: treat the machine as node 0
+        nodes.push_back(0);
+    }
+    std::sort(nodes.begin(), nodes.end());
+    return nodes;
+}
+
+size_t numaNodeCount() {
+    return onlineNumaNodes().size();
+}
+
+std::vector<int> cpusOfNode(int node) {
+    std::string list = readFirstLine("/sys/devices/system/node/node" +
+                                     std::to_string(node) + "/cpulist");
+    if (list.empty()) {
+        // Kernels without NUMA sysfs: treat the machine as node 0
+        if (node != 0) {
+            return {};
+        }
+        std::vector<int> cpus;
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        for (long cpu = 0; cpu < n; cpu++) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+        return cpus;
+    }
+    return parseList(list);
+}
+
+void pinCurrentThreadToNode(int node) {
+    std::vector<int> cpus = cpusOfNode(node);
+    if (cpus.empty()) {
+        throw std::runtime_error("NUMA node has no CPUs: " + std::to_string(node));
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        CPU_SET(cpu, &set);
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        throw std::runtime_error("Cannot pin thread to NUMA node " + std::to_string(node));
+    }
+}
+
+} // namespace atlas
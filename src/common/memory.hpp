@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * Page size policy for large allocations
+ *
+ * None:        regular 4 KB pages
+ * Transparent: regular mapping advised with MADV_HUGEPAGE (THP)
+ * Explicit:    MAP_HUGETLB from the reserved hugetlbfs pool, falling back
+ *              to Transparent when the pool is empty
+ */
+enum class HugePageMode { None, Transparent, Explicit };
+
+/**
+ * NUMA placement policy for large allocations
+ *
+ * Local:      first-touch (kernel default)
+ * Interleave: pages spread round-robin over all online nodes so that
+ *             threads on every socket see the same average latency
+ */
+enum class NumaMode { Local, Interleave };
+
+/**
+ * Memory placement policy for the big arenas (vector data, graph arrays)
+ */
+struct MemoryPolicy {
+    HugePageMode hugePages = HugePageMode::None;
+    NumaMode numa = NumaMode::Local;
+
+    bool isDefault() const {
+        return hugePages == HugePageMode::None && numa == NumaMode::Local;
+    }
+
+    bool operator==(const MemoryPolicy& other) const {
+        return hugePages == other.hugePages && numa == other.numa;
+    }
+};
+
+/**
+ * Allocate bytes according to policy
+ *
+ * Small requests and the default policy use plain operator new; only
+ * allocations of at least kPolicyThreshold bytes are mmap'ed with the
+ * requested page size and NUMA placement. Placement is best-effort: if
+ * the kernel refuses huge pages or mbind, regular pages are used.
+ *
+ * @throws std::bad_alloc if no memory could be obtained at all
+ */
+void* allocateWithPolicy(size_t bytes, const MemoryPolicy& policy);
+
+/**
+ * Release memory from allocateWithPolicy (same bytes and policy)
+ */
+void deallocateWithPolicy(void* ptr, size_t bytes, const MemoryPolicy& policy);
+
+// Allocations below this size ignore the policy (one huge page)
+constexpr size_t kPolicyThreshold = size_t(2) << 20;
+
+/**
+ * IDs of the online NUMA nodes, ascending ({0} on non-NUMA machines)
+ *
+ * Node IDs need not be contiguous (e.g. "0,2" with node 1 offline).
+ */
+std::vector<int> onlineNumaNodes();
+
+/**
+ * Number of online NUMA nodes (1 on non-NUMA machines)
+ */
+size_t numaNodeCount();
+
+/**
+ * CPUs that belong to a NUMA node
+ * @param node NUMA node index
+ * @return CPU ids, empty if the node does not exist
+ */
+std::vector<int> cpusOfNode(int node);
+
+/**
+ * Restrict the calling thread to the CPUs of one NUMA node (socket)
+ * @param node NUMA node index
+ * @throws std::runtime_error if the node has no CPUs or affinity fails
+ */
+void pinCurrentThreadToNode(int node);
+
+/**
+ * STL allocator that routes through allocateWithPolicy
+ *
+ * Lets arena containers (e.g. the VectorStore float arena) opt in to
+ * huge pages / NUMA interleave without changing how they are used.
+ */
+template <typename T>
+class PolicyAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    PolicyAllocator() = default;
+    explicit PolicyAllocator(const MemoryPolicy& policy) : policy_(policy) {}
+
+    template <typename U>
+    PolicyAllocator(const PolicyAllocator<U>& other) : policy_(other.policy()) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(allocateWithPolicy(n * sizeof(T), policy_));
+    }
+
+    void deallocate(T* ptr, size_t n) {
+        deallocateWithPolicy(ptr, n * sizeof(T), policy_);
+    }
+
+    const MemoryPolicy& policy() const { return policy_; }
+
+    template <typename U>
+    bool operator==(const PolicyAllocator<U>& other) const {
+        return policy_ == other.policy();
+    }
+
+private:
+    MemoryPolicy policy_;
+};
+
+} // namespace atlas
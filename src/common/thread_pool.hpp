@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * ThreadPool - Work-stealing executor
+ *
+ * Each worker owns a task deque. Tasks submitted from outside the pool
+ * are spread round-robin over the deques; tasks submitted from inside a
+ * worker go to that worker's own deque. A worker pops from the front of
+ * its own deque and, when empty, steals from the back of the others.
+ * The destructor runs every queued task before joining.
+ */
+class ThreadPool {
+public:
+    /**
+     * Constructor
+     * @param numThreads Number of worker threads (0 = hardware concurrency)
+     */
+    explicit ThreadPool(size_t numThreads = 0);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Schedule a callable
+     * @param fn Callable taking no arguments
+     * @return Future for the callable's result (exceptions propagate through it)
+     */
+    template <typename F>
+    auto submit(F&& fn) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(fn));
+        std::future<Result> future = task->get_future();
+        post([task]() { (*task)(); });
+        return future;
+    }
+
+    /**
+     * Run fn(begin, end) over [0, count) split into chunks across the pool
+     * and wait for all of them
+     * @param count Number of items
+     * @param fn Callable taking (size_t begin, size_t end)
+     * @throws The first exception thrown by a chunk, after every chunk finished
+     */
+    template <typename F>
+    void parallelFor(size_t count, F&& fn) {
+        size_t chunks = std::min(count, std::max<size_t>(size(), 1) * 4);
+        std::vector<std::future<void>> pending;
+        pending.reserve(chunks);
+        for (size_t c = 0; c < chunks; c++) {
+            size_t begin = count * c / chunks;
+            size_t end = count * (c + 1) / chunks;
+            pending.push_back(submit([&fn, begin, end]() { fn(begin, end); }));
+        }
+        waitAll(pending);
+    }
+
+    /**
+     * Wait for every future, then rethrow the first error (so no task
+     * still references the caller's data when the exception propagates)
+     * @return The results, in order
+     */
+    template <typename T>
+    static std::vector<T> waitAll(std::vector<std::future<T>>& futures) {
+        std::vector<T> results;
+        results.reserve(futures.size());
+        std::exception_ptr error;
+        for (auto& f : futures) {
+            try {
+                results.push_back(f.get());
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return results;
+    }
+
+    static void waitAll(std::vector<std::future<void>>& futures);
+
+    /**
+     * Get the number of worker threads
+     * @return Worker count
+     */
+    size_t size() const { return threads_.size(); }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void post(std::function<void()> task);
+    void workerLoop(size_t index);
+    bool popLocal(size_t index, std::function<void()>& task);
+    bool steal(size_t thief, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    size_t pending_;                // Posted, not yet started (guarded by sleepMutex_)
+    bool stopping_;                 // Set by the destructor (guarded by sleepMutex_)
+    std::atomic<size_t> nextQueue_; // Round-robin cursor for external submits
+};
+
+} // namespace atlas
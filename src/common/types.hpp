@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <numeric>
+#include <span>
 #include <vector>
 
 namespace atlas{
@@ -9,6 +12,9 @@ namespace atlas{
     using VectorId = uint64_t;
     
     using Vector = std::vector<float>;
+
+    //Read-only view of a vector (e.g. a row of the VectorStore arena)
+    using VectorView = std::span<const float>;
     
     using Distance = float;
 
@@ -29,7 +35,60 @@ namespace atlas{
         }
     };
 
+    /**
+     * Compact result buffer for range (radius) queries
+     *
+     * Range queries can return thousands of hits, so ids and distances are
+     * kept in two flat parallel arrays instead of one struct per hit. Results
+     * are appended in discovery order; call sortByDistance() for ranked output.
+     */
+    class RangeSearchResult{
+    public:
+        void add(VectorId id, Distance dist){
+            ids_.push_back(id);
+            distances_.push_back(dist);
+        }
+
+        size_t size() const { return ids_.size(); }
+        bool empty() const { return ids_.empty(); }
+
+        VectorId id(size_t i) const { return ids_[i]; }
+        Distance distance(size_t i) const { return distances_[i]; }
+
+        const std::vector<VectorId>& ids() const { return ids_; }
+        const std::vector<Distance>& distances() const { return distances_; }
+
+        void reserve(size_t n){
+            ids_.reserve(n);
+            distances_.reserve(n);
+        }
+
+        void clear(){
+            ids_.clear();
+            distances_.clear();
+        }
 
+        //Reorder both arrays so the closest hit comes first
+        void sortByDistance(){
+            std::vector<size_t> order(ids_.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [this](size_t a, size_t b){
+                return distances_[a] < distances_[b];
+            });
 
+            std::vector<VectorId> ids(order.size());
+            std::vector<Distance> distances(order.size());
+            for(size_t i = 0; i < order.size(); i++){
+                ids[i] = ids_[order[i]];
+                distances[i] = distances_[order[i]];
+            }
+            ids_.swap(ids);
+            distances_.swap(distances);
+        }
+
+    private:
+        std::vector<VectorId> ids_;
+        std::vector<Distance> distances_;
+    };
 
 }
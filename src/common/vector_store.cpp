@@ -6,7 +6,9 @@
 
 namespace atlas {
 
-VectorStore::VectorStore(size_t dimension) : dimension_(dimension) {
+VectorStore::VectorStore(size_t dimension, const MemoryPolicy &policy)
+    : data_(PolicyAllocator<float>(policy)), dimension_(dimension),
+      distanceFn_(selectCosineDistance(dimension)) {
   if (dimension == 0) {
     throw std::invalid_argument("Dimension must be greater than 0");
   }
@@ -21,16 +23,53 @@ void VectorStore::addVector(VectorId id, const Vector &vec) {
   }
 
   // Check for duplicate ID
-  if (vectors_.find(id) != vectors_.end()) {
-    throw std::invalid_argument("Duplicate vector ID: " + std::to_string(id));
+  checkNewId(id);
+
+  // Append the vector to the arena
+  slots_.emplace(id, ids_.size());
+  ids_.push_back(id);
+  data_.insert(data_.end(), vec.begin(), vec.end());
+}
+
+void VectorStore::addVectors(std::span<const VectorId> ids,
+                             std::span<const float> data) {
+  // Validate batch shape
+  if (data.size() != ids.size() * dimension_) {
+    throw std::invalid_argument("Batch size mismatch: expected " +
+                                std::to_string(ids.size() * dimension_) +
+                                " floats, got " + std::to_string(data.size()));
   }
 
-  // Store the vector
-  vectors_[id] = vec;
+  // Validate every ID before touching storage so a bad batch is a no-op
+  std::unordered_map<VectorId, size_t> batchSlots;
+  batchSlots.reserve(ids.size());
+  for (size_t i = 0; i < ids.size(); i++) {
+    checkNewId(ids[i]);
+    if (!batchSlots.emplace(ids[i], ids_.size() + i).second) {
+      throw std::invalid_argument("Duplicate vector ID: " +
+                                  std::to_string(ids[i]));
+    }
+  }
+
+  slots_.merge(batchSlots);
+  ids_.insert(ids_.end(), ids.begin(), ids.end());
+  data_.insert(data_.end(), data.begin(), data.end());
+}
+
+void VectorStore::reserve(size_t capacity) {
+  data_.reserve(capacity * dimension_);
+  ids_.reserve(capacity);
+  slots_.reserve(capacity);
+}
+
+void VectorStore::checkNewId(VectorId id) const {
+  if (slots_.find(id) != slots_.end()) {
+    throw std::invalid_argument("Duplicate vector ID: " + std::to_string(id));
+  }
 }
 
 std::vector<VectorWithDistance>
-VectorStore::bruteForceSearch(const Vector &query, size_t k) {
+VectorStore::bruteForceSearch(const Vector &query, size_t k) const {
   // Validate query dimension
   if (query.size() != dimension_) {
     throw std::invalid_argument("Query dimension mismatch: expected " +
@@ -39,20 +78,20 @@ VectorStore::bruteForceSearch(const Vector &query, size_t k) {
   }
 
   // Handle empty store
-  if (vectors_.empty()) {
+  if (ids_.empty()) {
     return {};
   }
 
-  // Compute distances to all vectors
+  // Compute distances to all vectors (sequential walk over the arena)
   std::vector<VectorWithDistance> results;
-  results.reserve(vectors_.size());
-
-  for (const auto &[id, vec] : vectors_) {
-    // Compute cosine similarity and convert to distance
-    // Distance = 1 - similarity (so smaller distance = more similar)
-    float similarity = cosineSimilarity(query, vec);
-    float distance = 1.0f - similarity;
-    results.emplace_back(id, distance);
+  results.reserve(ids_.size());
+
+  for (size_t slot = 0; slot < ids_.size(); slot++) {
+    // Distance = 1 - cosine similarity (so smaller distance = more similar),
+    // via the kernel selected for this dimension
+    VectorView vec(data_.data() + slot * dimension_, dimension_);
+    float distance = cosineDistance(query, vec);
+    results.emplace_back(ids_[slot], distance);
   }
 
   // Sort by distance (ascending - closest first)
@@ -70,15 +109,71 @@ VectorStore::bruteForceSearch(const Vector &query, size_t k) {
   return results;
 }
 
-size_t VectorStore::size() const { return vectors_.size(); }
+RangeSearchResult VectorStore::rangeSearch(const Vector &query,
+                                           Distance radius) const {
+  // Validate query dimension
+  if (query.size() != dimension_) {
+    throw std::invalid_argument("Query dimension mismatch: expected " +
+                                std::to_string(dimension_) + ", got " +
+                                std::to_string(query.size()));
+  }
+
+  RangeSearchResult results;
+  for (size_t slot = 0; slot < ids_.size(); slot++) {
+    VectorView vec(data_.data() + slot * dimension_, dimension_);
+    float distance = cosineDistance(query, vec);
+    if (distance <= radius) {
+      results.add(ids_[slot], distance);
+    }
+  }
+
+  results.sortByDistance();
+  return results;
+}
+
+void VectorStore::reorder(std::span<const VectorId> order) {
+  if (order.size() != ids_.size()) {
+    throw std::invalid_argument("Reorder size mismatch: expected " +
+                                std::to_string(ids_.size()) + " IDs, got " +
+                                std::to_string(order.size()));
+  }
+
+  decltype(data_) data(data_.size(), 0.0f, data_.get_allocator());
+  std::vector<bool> placed(ids_.size(), false);
+  for (size_t slot = 0; slot < order.size(); slot++) {
+    auto it = slots_.find(order[slot]);
+    if (it == slots_.end() || placed[it->second]) {
+      throw std::invalid_argument("Reorder is not a permutation: bad ID " +
+                                  std::to_string(order[slot]));
+    }
+    placed[it->second] = true;
+    std::copy_n(data_.begin() + it->second * dimension_, dimension_,
+                data.begin() + slot * dimension_);
+  }
+
+  // All IDs validated, commit the new layout
+  data_.swap(data);
+  ids_.assign(order.begin(), order.end());
+  for (size_t slot = 0; slot < ids_.size(); slot++) {
+    slots_[ids_[slot]] = slot;
+  }
+}
+
+std::span<const VectorId> VectorStore::ids() const { return ids_; }
+
+size_t VectorStore::size() const { return ids_.size(); }
 
 bool VectorStore::contains(VectorId id) const {
-  return vectors_.find(id) != vectors_.end();
+  return slots_.find(id) != slots_.end();
 }
 
-const Vector &VectorStore::getVector(VectorId id) const {
-  auto it = vectors_.find(id);
-  if (it == vectors_.end()) {
+VectorView VectorStore::getVector(VectorId id) const {
+  return vectorAt(slotOf(id));
+}
+
+size_t VectorStore::slotOf(VectorId id) const {
+  auto it = slots_.find(id);
+  if (it == slots_.end()) {
     throw std::out_of_range("Vector ID not found: " + std::to_string(id));
   }
   return it->second;
@@ -86,4 +181,8 @@ const Vector &VectorStore::getVector(VectorId id) const {
 
 size_t VectorStore::getDimension() const { return dimension_; }
 
+MemoryPolicy VectorStore::getMemoryPolicy() const {
+  return data_.get_allocator().policy();
+}
+
 } // namespace atlas
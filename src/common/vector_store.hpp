@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../common/types.hpp"
+#include "../distance/distance.hpp"
+#include "memory.hpp"
 #include <stdexcept>
 #include <unordered_map>
 #include <vector>
@@ -12,18 +14,32 @@ namespace atlas {
  *
  * Provides efficient storage and retrieval of vectors by ID,
  * and brute-force similarity search using cosine similarity.
+ *
+ * Vectors live back to back in one row-major float arena (slot i occupies
+ * [i * dimension, (i + 1) * dimension)), so adding a vector never allocates
+ * on its own and scans walk memory sequentially. Views returned by
+ * getVector() are invalidated by later insertions, like vector iterators.
+ * The arena can be placed on huge pages / interleaved across NUMA nodes
+ * via a MemoryPolicy.
  */
 class VectorStore {
 private:
-  std::unordered_map<VectorId, Vector> vectors_; // ID -> Vector mapping
-  size_t dimension_;                             // Expected vector dimension
+  std::vector<float, PolicyAllocator<float>> data_; // Row-major vector arena
+  std::vector<VectorId> ids_;                       // Slot -> ID
+  std::unordered_map<VectorId, size_t> slots_;      // ID -> slot
+  size_t dimension_;                                // Expected vector dimension
+  CosineDistanceFn distanceFn_; // Kernel chosen once for dimension_
+
+  // Throw if id is already stored
+  void checkNewId(VectorId id) const;
 
 public:
   /**
    * Constructor
    * @param dimension The dimensionality of vectors to store
+   * @param policy Page size / NUMA placement of the vector arena
    */
-  explicit VectorStore(size_t dimension);
+  explicit VectorStore(size_t dimension, const MemoryPolicy &policy = {});
 
   /**
    * Add a vector to the store
@@ -33,6 +49,21 @@ public:
    */
   void addVector(VectorId id, const Vector &vec);
 
+  /**
+   * Append a batch of vectors with one copy into the arena
+   * @param ids IDs of the vectors, one per row
+   * @param data Row-major floats, ids.size() * dimension values
+   * @throws std::invalid_argument if data size mismatches or an ID is
+   *         duplicated (the store is left unchanged in that case)
+   */
+  void addVectors(std::span<const VectorId> ids, std::span<const float> data);
+
+  /**
+   * Pre-size the arena and ID index for a known number of vectors
+   * @param capacity Total number of vectors expected
+   */
+  void reserve(size_t capacity);
+
   /**
    * Search for the k most similar vectors using brute-force
    * @param query The query vector to search for
@@ -40,7 +71,61 @@ public:
    * @return Vector of (id, distance) pairs, sorted by distance ascending
    */
   std::vector<VectorWithDistance> bruteForceSearch(const Vector &query,
-                                                   size_t k);
+                                                   size_t k) const;
+
+  /**
+   * Find every vector within a distance threshold using brute-force
+   * @param query The query vector to search for
+   * @param radius Maximum cosine distance (1 - similarity) to include
+   * @return All matches, sorted by distance ascending
+   */
+  RangeSearchResult rangeSearch(const Vector &query, Distance radius) const;
+
+  /**
+   * Permute the arena so vectors are laid out in the given ID order
+   *
+   * IDs are unchanged; only physical placement moves. Used to put
+   * vectors that are searched together (e.g. graph neighbors) next to
+   * each other in memory.
+   *
+   * @param order Every stored ID exactly once, in the desired slot order
+   * @throws std::invalid_argument if order is not a permutation of the IDs
+   */
+  void reorder(std::span<const VectorId> order);
+
+  /**
+   * Get the stored IDs in arena (slot) order
+   * @return View of the slot -> ID table
+   */
+  std::span<const VectorId> ids() const;
+
+  /**
+   * Get the arena slot of a stored ID (stable until the next reorder())
+   * @param id The vector ID to look up
+   * @return Slot index, < size()
+   * @throws std::out_of_range if ID not found
+   */
+  size_t slotOf(VectorId id) const;
+
+  /**
+   * Row of a slot without an ID lookup (for slot-indexed structures)
+   * @param slot Slot index, must be < size()
+   * @return View of the slot's row in the arena
+   */
+  VectorView vectorAt(size_t slot) const {
+    return VectorView(data_.data() + slot * dimension_, dimension_);
+  }
+
+  /**
+   * Cosine distance (1 - similarity) between two vectors of this store's
+   * dimension, using the kernel specialized for that dimension if any
+   * @param a First vector (must have getDimension() elements)
+   * @param b Second vector (must have getDimension() elements)
+   * @return Distance, smaller = more similar
+   */
+  Distance cosineDistance(VectorView a, VectorView b) const {
+    return distanceFn_(a.data(), b.data(), dimension_);
+  }
 
   /**
    * Get the number of vectors in the store
@@ -58,16 +143,22 @@ public:
   /**
    * Retrieve a vector by ID
    * @param id The vector ID to retrieve
-   * @return Reference to the vector
+   * @return View of the vector's row in the arena
    * @throws std::out_of_range if ID not found
    */
-  const Vector &getVector(VectorId id) const;
+  VectorView getVector(VectorId id) const;
 
   /**
    * Get the dimension of vectors in this store
    * @return The vector dimension
    */
   size_t getDimension() const;
+
+  /**
+   * Get the placement policy of the vector arena
+   * @return The memory policy passed at construction
+   */
+  MemoryPolicy getMemoryPolicy() const;
 };
 
 } // namespace atlas
@@ -1,12 +1,13 @@
 #include "../distance/distance.hpp"
 #include <cmath>
+#include <cstring>
 #include <stdexcept>
 
 namespace atlas {
 
 // TODO: Implement your distance functions here
 
-float dotProduct(const std::vector<float>& a, const std::vector<float>& b){
+float dotProduct(std::span<const float> a, std::span<const float> b){
     if (a.size() != b.size()){
         throw std::invalid_argument("vectors must be same size");
     }
@@ -19,7 +20,7 @@ float dotProduct(const std::vector<float>& a, const std::vector<float>& b){
     return res;
 }
 
-float magnitude(const std::vector<float>& vec){
+float magnitude(std::span<const float> vec){
     float sumOfSquares = 0.0f;
     // iterates through indices for sum of squares
     for (float value : vec){
@@ -27,7 +28,10 @@ float magnitude(const std::vector<float>& vec){
     }
     return std::sqrt(sumOfSquares);
 }
-float cosineSimilarity(const std::vector<float>& a, const std::vector<float>& b){
+bool isZeroMagnitude(std::span<const float> a){
+    return magnitude(a) < 1e-6;
+}
+float cosineSimilarity(std::span<const float> a, std::span<const float> b){
     float mag_a = magnitude(a);
     float mag_b = magnitude(b);
 
@@ -39,7 +43,7 @@ float cosineSimilarity(const std::vector<float>& a, const std::vector<float>& b)
     float dot = dotProduct(a,b);
     return dot / (mag_a * mag_b);
 }
-void normalize(std::vector<float>& vec){
+void normalize(std::span<float> vec){
     
     float mag = magnitude(vec);
 
@@ -53,6 +57,75 @@ void normalize(std::vector<float>& vec){
     }
 }
 
+float cosineDistanceGeneric(const float* a, const float* b, size_t dim){
+    return 1.0f - cosineSimilarity(std::span<const float>(a, dim), std::span<const float>(b, dim));
+}
+
+namespace {
+
+// eight floats as one SIMD register (GCC/Clang vector extension);
+// maps to AVX with -march=native and to SSE pairs otherwise
+typedef float Float8 __attribute__((vector_size(8 * sizeof(float))));
+
+// fused single pass over both rows: dot, |a|^2 and |b|^2 together.
+// Dim is a compile-time constant, so there is no tail loop and the
+// compiler can unroll freely; two accumulator sets hide FMA latency
+template <size_t Dim>
+float cosineDistanceFixed(const float* a, const float* b, size_t /*dim*/){
+    static_assert(Dim % 16 == 0, "fixed kernels need a multiple of 16 dims");
+
+    Float8 dot0 = {}, normA0 = {}, normB0 = {};
+    Float8 dot1 = {}, normA1 = {}, normB1 = {};
+
+    for (size_t i = 0; i < Dim; i += 16){
+        // unaligned loads (arena rows are only float-aligned)
+        Float8 x0, y0, x1, y1;
+        std::memcpy(&x0, a + i, sizeof(Float8));
+        std::memcpy(&y0, b + i, sizeof(Float8));
+        std::memcpy(&x1, a + i + 8, sizeof(Float8));
+        std::memcpy(&y1, b + i + 8, sizeof(Float8));
+        dot0 += x0 * y0;
+        normA0 += x0 * x0;
+        normB0 += y0 * y0;
+        dot1 += x1 * y1;
+        normA1 += x1 * x1;
+        normB1 += y1 * y1;
+    }
+
+    Float8 dot = dot0 + dot1, normA = normA0 + normA1, normB = normB0 + normB1;
+    float sumDot = 0.0f, sumA = 0.0f, sumB = 0.0f;
+    for (size_t l = 0; l < 8; l++){
+        sumDot += dot[l];
+        sumA += normA[l];
+        sumB += normB[l];
+    }
+
+    float mag_a = std::sqrt(sumA);
+    float mag_b = std::sqrt(sumB);
+
+    // edge case for zero magnitude
+    if (mag_a < 1e-6 || mag_b < 1e-6){
+        throw std::invalid_argument("vectors must have non-zero magnitude");
+    }
+    return 1.0f - sumDot / (mag_a * mag_b);
+}
+
+} // namespace
+
+CosineDistanceFn selectCosineDistance(size_t dim){
+    switch (dim){
+        case 128:  return cosineDistanceFixed<128>;
+        case 384:  return cosineDistanceFixed<384>;
+        case 768:  return cosineDistanceFixed<768>;
+        case 1536: return cosineDistanceFixed<1536>;
+        default:   return cosineDistanceGeneric;
+    }
+}
+
+bool hasFixedDimensionKernel(size_t dim){
+    return selectCosineDistance(dim) != cosineDistanceGeneric;
+}
+
 
 
 } // namespace atlas
@@ -1,21 +1,44 @@
 #ifndef DISTANCE_HPP
 #define DISTANCE_HPP
 
+#include <cstddef>
+#include <span>
 #include <vector>
 
 namespace atlas {
 
+// Kernels take spans so they work on std::vector<float> and on rows of the
+// VectorStore arena alike (std::vector converts implicitly)
+
 // computing the dot product of two vectors
-float dotProduct(const std::vector<float>& a, const std::vector<float>& b);
+float dotProduct(std::span<const float> a, std::span<const float> b);
 
 // computing the magnitude of a vector
-float magnitude(const std::vector<float>& a);
+float magnitude(std::span<const float> a);
+
+// true if the cosine kernels reject the vector (magnitude below 1e-6)
+bool isZeroMagnitude(std::span<const float> a);
 
 // computing the cosine similarity of two vectors
-float cosineSimilarity(const std::vector<float>& a, const std::vector<float>& b);
+float cosineSimilarity(std::span<const float> a, std::span<const float> b);
 
 // normalizing a vector 
-void normalize(std::vector<float>& vec);
+void normalize(std::span<float> vec);
+
+// cosine distance (1 - similarity) between two rows of length dim
+// (same zero-magnitude check as cosineSimilarity)
+using CosineDistanceFn = float (*)(const float* a, const float* b, size_t dim);
+
+// generic kernel: any dimension, runtime trip count
+float cosineDistanceGeneric(const float* a, const float* b, size_t dim);
+
+// picks the fully unrolled kernel for common dimensions
+// (128, 384, 768, 1536), the generic one otherwise;
+// call once per collection and keep the pointer
+CosineDistanceFn selectCosineDistance(size_t dim);
+
+// true if selectCosineDistance has a fixed-dimension kernel for dim
+bool hasFixedDimensionKernel(size_t dim);
 
 } // namespace atlas
 
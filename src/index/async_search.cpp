@@ -0,0 +1,41 @@
+#include "async_search.hpp"
+
+namespace atlas {
+
+AsyncSearcher::AsyncSearcher(HNSW& index, size_t numThreads)
+    : index_(index), pool_(numThreads) {}
+
+std::future<AsyncSearchResult> AsyncSearcher::submit(
+    Vector query, size_t k, size_t efSearch,
+    std::chrono::steady_clock::time_point deadline, CancellationToken token) {
+
+    return pool_.submit([this, query = std::move(query), k, efSearch, deadline, token]() {
+        AsyncSearchResult out;
+
+        // abandoned before we got to it: don't burn a core on it
+        if (token.isCancelled()) {
+            out.stats.cancelled = true;
+            return out;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            out.stats.truncated = true;
+            out.expiredInQueue = true;
+            return out;
+        }
+
+        SearchBudget budget;
+        budget.deadline = deadline;
+        budget.cancel = token.flag();
+        out.results = index_.search(query, k, efSearch, budget, &out.stats);
+        return out;
+    });
+}
+
+std::future<AsyncSearchResult> AsyncSearcher::submit(
+    Vector query, size_t k, size_t efSearch,
+    std::chrono::microseconds timeout, CancellationToken token) {
+    return submit(std::move(query), k, efSearch,
+                  std::chrono::steady_clock::now() + timeout, std::move(token));
+}
+
+} // namespace atlas
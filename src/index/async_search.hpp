@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../common/thread_pool.hpp"
+#include "../common/types.hpp"
+#include "hnsw.hpp"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * Shared cancellation flag for one or more queries
+ *
+ * Copies refer to the same flag, so the client can keep one copy and
+ * cancel while the search holds another.
+ */
+class CancellationToken {
+public:
+    CancellationToken() : flag_(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() { flag_->store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return flag_->load(std::memory_order_relaxed); }
+
+    // Raw flag polled by HNSW::searchLayer
+    const std::atomic<bool>* flag() const { return flag_.get(); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag_;
+};
+
+/**
+ * Outcome of an asynchronous search
+ */
+struct AsyncSearchResult {
+    std::vector<VectorWithDistance> results;  // Best (possibly partial) top-k
+    SearchStats stats;                        // Work done; truncated/cancelled flags
+    bool expiredInQueue = false;              // Deadline passed before the search started
+};
+
+/**
+ * AsyncSearcher - Runs HNSW searches on a work-stealing pool
+ *
+ * Every query carries a deadline and a cancellation token. The search
+ * loop polls both once per expansion and returns the best partial results
+ * when either fires; queries whose deadline passed while still queued are
+ * dropped without touching the graph. Searches may run concurrently with
+ * each other but not with inserts into the index.
+ */
+class AsyncSearcher {
+public:
+    /**
+     * Constructor
+     * @param index Index to search (must outlive the searcher)
+     * @param numThreads Worker threads (0 = hardware concurrency)
+     */
+    explicit AsyncSearcher(HNSW& index, size_t numThreads = 0);
+
+    /**
+     * Submit a query
+     *
+     * @param query Query vector (copied)
+     * @param k Number of nearest neighbors to return
+     * @param efSearch Size of dynamic candidate list
+     * @param deadline Point in time after which partial results are returned
+     * @param token Cancellation token (default: never cancelled)
+     * @return Future for the (possibly partial) results
+     */
+    std::future<AsyncSearchResult> submit(Vector query, size_t k, size_t efSearch,
+                                          std::chrono::steady_clock::time_point deadline,
+                                          CancellationToken token = CancellationToken());
+
+    /**
+     * Submit a query with a relative timeout
+     */
+    std::future<AsyncSearchResult> submit(Vector query, size_t k, size_t efSearch,
+                                          std::chrono::microseconds timeout,
+                                          CancellationToken token = CancellationToken());
+
+private:
+    HNSW& index_;
+    ThreadPool pool_;
+};
+
+} // namespace atlas
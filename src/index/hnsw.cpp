@@ -3,10 +3,48 @@
 #include <unordered_set>
 #include <algorithm>
 #include "../distance/distance.hpp"
+#include "../common/thread_pool.hpp"
 #include <cmath>
+#include <limits>
+#include <stdexcept>
 
 namespace atlas {
 
+namespace {
+
+// Visited marks for graph walks, kept per thread and reused: starting a
+// walk bumps the epoch instead of clearing (or allocating) a set
+struct VisitedSlots {
+    std::vector<uint32_t> marks;
+    uint32_t epoch = 0;
+
+    // Start a new walk over slots [0, count)
+    void reset(size_t count) {
+        if (marks.size() < count) {
+            marks.resize(count, 0);
+        }
+        if (++epoch == 0) {
+            std::fill(marks.begin(), marks.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    bool contains(size_t slot) const { return marks[slot] == epoch; }
+
+    // True the first time slot is seen in this walk
+    bool insert(size_t slot) {
+        if (marks[slot] == epoch) {
+            return false;
+        }
+        marks[slot] = epoch;
+        return true;
+    }
+};
+
+thread_local VisitedSlots visitedSlots;
+
+} // namespace
+
 HNSW::HNSW(VectorStore& store, size_t M, size_t efConstruction)
     : store_(store),
       M_(M),
@@ -15,35 +53,46 @@ HNSW::HNSW(VectorStore& store, size_t M, size_t efConstruction)
       rng_(std::random_device{}()),
       uniform_dist_(0.0, 1.0),
       entryPoint_(0),
-      maxLevel_(-1) {
+      maxLevel_(-1),
+      generation_(0),
+      entrySeeds_(0) {
     // TODO: Initialize any graph data structures you design
 }
 
 void HNSW::addVector(VectorId id) {
+    // get the vector for this node; reject it before touching the graph
+    // (a zero vector as entry point would make every later distance throw)
+    Slot slot = static_cast<Slot>(store_.slotOf(id));
+    VectorView newVec = store_.vectorAt(slot);
+    if (isZeroMagnitude(newVec)) {
+        throw std::invalid_argument("Vector " + std::to_string(id) + " has zero magnitude");
+    }
+
     //select random layer for this node
     int nodeLevel = selectLevel();
     
-    // create the node in our graph
-    nodes_[id] = HNSWNode(nodeLevel);
+    // create the node in our graph (the table grows with the store)
+    if (slot >= nodes_.size()) {
+        nodes_.resize(store_.size());
+    }
+    nodes_[slot] = HNSWNode(nodeLevel);
+    generation_++;
     
     // first node insertion
     if (maxLevel_ == -1) {
-        entryPoint_ = id;
+        entryPoint_ = slot;
         maxLevel_ = nodeLevel;
         return;  // First node has no neighbors to connect
     }
     
-    // get the query vector for this node
-    const Vector& newVec = store_.getVector(id);
-    
     // find insertion point by descending from entry point
-    VectorId currNode = entryPoint_;
+    Slot currNode = entryPoint_;
     
     // Descend through layers above our node's level (greedy search, ef=1)
     for (int layer = maxLevel_; layer > nodeLevel; layer--) {
         auto nearest = searchLayer(newVec, {currNode}, 1, layer);
         if (!nearest.empty()) {
-            currNode = nearest[0].id;
+            currNode = nearest[0].second;
         }
     }
     
@@ -56,23 +105,22 @@ void HNSW::addVector(VectorId id) {
         size_t numConnections = std::min(M_, neighbors.size());
         
         for (size_t i = 0; i < numConnections; i++) {
-            VectorId neighborId = neighbors[i].id;
+            Slot neighborSlot = neighbors[i].second;
             
             // Add edge
-            nodes_[id].neighbors[layer].push_back(neighborId);
-            nodes_[neighborId].neighbors[layer].push_back(id);
+            nodes_[slot].neighbors[layer].push_back(neighborSlot);
+            nodes_[neighborSlot].neighbors[layer].push_back(slot);
             
             // Prune neighbor's connections if they exceed M
-            if (nodes_[neighborId].neighbors[layer].size() > M_) {
+            if (nodes_[neighborSlot].neighbors[layer].size() > M_) {
                 // Simple pruning: keep only M closest neighbors
-                auto& neighborList = nodes_[neighborId].neighbors[layer];
-                const Vector& neighborVec = store_.getVector(neighborId);
+                auto& neighborList = nodes_[neighborSlot].neighbors[layer];
+                VectorView neighborVec = store_.vectorAt(neighborSlot);
                 
                 // calculate distances
-                std::vector<std::pair<float, VectorId>> scored;
+                std::vector<ScoredSlot> scored;
                 for (auto n : neighborList) {
-                    float sim = cosineSimilarity(neighborVec, store_.getVector(n));
-                    scored.push_back({1.0f - sim, n});
+                    scored.push_back({store_.cosineDistance(neighborVec, store_.vectorAt(n)), n});
                 }
                 
                 // Sort by distance and keep only M closest
@@ -86,43 +134,595 @@ void HNSW::addVector(VectorId id) {
         
         // Update entry point for next layer
         if (!neighbors.empty()) {
-            currNode = neighbors[0].id;
+            currNode = neighbors[0].second;
         }
     }
     
     // update entry point if this node has higher level
     if (nodeLevel > maxLevel_) {
-        entryPoint_ = id;
+        entryPoint_ = slot;
         maxLevel_ = nodeLevel;
     }
 }
 
 std::vector<VectorWithDistance> HNSW::search(const Vector& query, size_t k, size_t efSearch) {
+    return search(VectorView(query), k, efSearch);
+}
+
+std::vector<VectorWithDistance> HNSW::search(VectorView query, size_t k, size_t efSearch) {
+    validateQuery(query);
+
     // Handle empty graph
-    if (maxLevel_ == -1 || nodes_.empty()) {
+    if (maxLevel_ == -1) {
         return {};
     }
     
-    // start at entry point
-    VectorId currNode = entryPoint_;
-    
-    // descend through upper layers (greedy, ef=1)
-    for (int layer = maxLevel_; layer > 0; layer--) {
-        auto nearest = searchLayer(query, {currNode}, 1, layer);
-        if (!nearest.empty()) {
-            currNode = nearest[0].id;
-        }
-    }
+    // start at entry point and descend through upper layers (greedy, ef=1),
+    // or jump straight to the closest precomputed entry points
+    auto seeds = baseLayerSeeds(query);
     
     // at layer 0, expanded search with efSearch candidates
-    auto results = searchLayer(query, {currNode}, std::max(k, efSearch), 0);
+    auto results = searchLayer(query, seeds, std::max(k, efSearch), 0);
     
     // return top k results
     if (results.size() > k) {
         results.resize(k);
     }
     
-    return results;
+    return toResults(results);
+}
+
+std::vector<VectorWithDistance> HNSW::search(const Vector& query, size_t k, size_t efSearch,
+                                             const SearchBudget& budget, SearchStats* stats) {
+    validateQuery(query);
+
+    SearchStats localStats;
+    SearchStats& out = stats ? *stats : localStats;
+    out = SearchStats{};
+
+    // Handle empty graph
+    if (maxLevel_ == -1) {
+        return {};
+    }
+
+    SearchContext ctx{budget, out, k, false, {}};
+    if (budget.maxTime.count() > 0) {
+        ctx.hasDeadline = true;
+        ctx.deadline = std::chrono::steady_clock::now() + budget.maxTime;
+    }
+    if (budget.deadline != std::chrono::steady_clock::time_point{}) {
+        ctx.deadline = ctx.hasDeadline ? std::min(ctx.deadline, budget.deadline) : budget.deadline;
+        ctx.hasDeadline = true;
+    }
+
+    // descend through upper layers (greedy, ef=1); these count against the budget too
+    std::vector<Slot> seeds;
+    if (!entryPoints_.empty()) {
+        seeds = baseLayerSeeds(query);
+        out.distanceComputations += entryPoints_.size();
+    } else {
+        Slot currNode = entryPoint_;
+        for (int layer = maxLevel_; layer > 0; layer--) {
+            auto nearest = searchLayer(query, {currNode}, 1, layer, &ctx);
+            if (!nearest.empty()) {
+                currNode = nearest[0].second;
+            }
+            // budget ran out during descent: the greedy node is the best we have
+            if (ctx.exhausted()) {
+                return toResults(nearest);
+            }
+        }
+        seeds.push_back(currNode);
+    }
+
+    // at layer 0, expand up to efSearch candidates or until the budget stops us
+    auto results = searchLayer(query, seeds, std::max(k, efSearch), 0, &ctx);
+
+    if (results.size() > k) {
+        results.resize(k);
+    }
+
+    return toResults(results);
+}
+
+bool HNSW::SearchContext::distanceCapReached() {
+    if (budget.maxDistanceComputations > 0 &&
+        stats.distanceComputations >= budget.maxDistanceComputations) {
+        stats.truncated = true;
+    }
+    return stats.truncated;
+}
+
+bool HNSW::SearchContext::exhausted() {
+    if (distanceCapReached()) {
+        return true;
+    }
+    if (budget.cancel != nullptr && budget.cancel->load(std::memory_order_relaxed)) {
+        stats.cancelled = true;
+        return true;
+    }
+    if (hasDeadline && std::chrono::steady_clock::now() >= deadline) {
+        stats.truncated = true;
+    }
+    return stats.truncated;
+}
+
+RangeSearchResult HNSW::rangeSearch(const Vector& query, Distance radius, size_t efSearch) {
+    validateQuery(query);
+
+    RangeSearchResult matches;
+
+    // Handle empty graph
+    if (maxLevel_ == -1) {
+        return matches;
+    }
+
+    // seed with a normal layer-0 search so we start inside the radius if possible
+    auto seeds = searchLayer(query, baseLayerSeeds(query), std::max<size_t>(efSearch, 1), 0);
+
+    auto ids = store_.ids();
+    VisitedSlots& visited = visitedSlots;
+    visited.reset(nodes_.size());
+    std::priority_queue<ScoredSlot, std::vector<ScoredSlot>,
+                        std::greater<ScoredSlot>> candidates;  // Min-heap
+
+    for (const auto& seed : seeds) {
+        visited.insert(seed.second);
+        if (seed.first <= radius) {
+            candidates.push(seed);
+            matches.add(ids[seed.second], seed.first);
+        }
+    }
+
+    // flood outward: only nodes inside the radius are expanded, so the
+    // search stops as soon as no candidate lies within it
+    while (!candidates.empty()) {
+        auto curr = candidates.top();
+        candidates.pop();
+
+        for (auto neighbor : nodes_[curr.second].neighbors[0]) {
+            if (!visited.insert(neighbor)) {
+                continue;
+            }
+            float dist = store_.cosineDistance(query, store_.vectorAt(neighbor));
+            if (dist <= radius) {
+                candidates.push({dist, neighbor});
+                matches.add(ids[neighbor], dist);
+            }
+        }
+    }
+
+    matches.sortByDistance();
+    return matches;
+}
+
+std::vector<VectorId> HNSW::localityOrder() const {
+    auto ids = store_.ids();
+    std::vector<VectorId> order;
+    for (Slot slot : localitySlotOrder()) {
+        order.push_back(ids[slot]);
+    }
+    return order;
+}
+
+std::vector<HNSW::Slot> HNSW::localitySlotOrder() const {
+    std::vector<Slot> order;
+    order.reserve(nodes_.size());
+    if (maxLevel_ == -1) {
+        return order;
+    }
+
+    std::vector<bool> visited(nodes_.size(), false);
+    std::vector<std::pair<size_t, Slot>> frontier;  // (degree, slot) of newly found neighbors
+
+    // BFS from one root, enqueueing neighbors in ascending degree (Cuthill-McKee)
+    auto bfsFrom = [&](Slot root) {
+        size_t head = order.size();
+        order.push_back(root);
+        visited[root] = true;
+        while (head < order.size()) {
+            const auto& neighbors = nodes_[order[head++]].neighbors[0];
+            frontier.clear();
+            for (auto neighbor : neighbors) {
+                if (!visited[neighbor]) {
+                    visited[neighbor] = true;
+                    frontier.push_back({nodes_[neighbor].neighbors[0].size(), neighbor});
+                }
+            }
+            std::sort(frontier.begin(), frontier.end());
+            for (const auto& entry : frontier) {
+                order.push_back(entry.second);
+            }
+        }
+    };
+
+    bfsFrom(entryPoint_);
+
+    // pick up any components not reachable from the entry point
+    for (size_t slot = 0; slot < nodes_.size(); slot++) {
+        if (isIndexed(slot) && !visited[slot]) {
+            bfsFrom(static_cast<Slot>(slot));
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+void HNSW::reorderForLocality() {
+    std::vector<Slot> order = localitySlotOrder();
+
+    // vectors the index does not cover keep their relative order at the end
+    if (order.size() < store_.size()) {
+        for (size_t slot = 0; slot < store_.size(); slot++) {
+            if (!isIndexed(slot)) {
+                order.push_back(static_cast<Slot>(slot));
+            }
+        }
+    }
+
+    auto ids = store_.ids();
+    std::vector<VectorId> idOrder(order.size());
+    std::vector<Slot> renamed(order.size());  // Old slot -> new slot
+    for (size_t i = 0; i < order.size(); i++) {
+        idOrder[i] = ids[order[i]];
+        renamed[order[i]] = static_cast<Slot>(i);
+    }
+    store_.reorder(idOrder);
+
+    // rebuild the node table in the new slot order, renumbering every
+    // adjacency list into a fresh buffer so the lists are allocated in the
+    // same order as the vectors
+    std::vector<HNSWNode> reordered(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        if (!isIndexed(order[i])) {
+            continue;
+        }
+        const HNSWNode& old = nodes_[order[i]];
+        HNSWNode& node = reordered[i] = HNSWNode(old.topLayer);
+        for (int layer = 0; layer <= node.topLayer; layer++) {
+            // room for the transient M+1-th edge addVector adds before pruning
+            node.neighbors[layer].reserve(std::max(M_ + 1, old.neighbors[layer].size()));
+            for (Slot neighbor : old.neighbors[layer]) {
+                node.neighbors[layer].push_back(renamed[neighbor]);
+            }
+        }
+    }
+    nodes_.swap(reordered);
+
+    if (maxLevel_ != -1) {
+        entryPoint_ = renamed[entryPoint_];
+    }
+    for (Slot& entry : entryPoints_) {
+        entry = renamed[entry];
+    }
+}
+
+void HNSW::merge(const std::vector<const HNSW*>& parts, ThreadPool& pool, size_t efMerge) {
+    if (maxLevel_ != -1) {
+        throw std::invalid_argument("Merge target must be empty");
+    }
+
+    // adopt every partition's nodes and intra-partition edges, renumbered
+    // from partition slots to slots of this index's store
+    std::vector<HNSWNode> merged(store_.size());
+    std::vector<std::vector<Slot>> renamed(parts.size());  // Partition slot -> slot here
+    std::vector<Slot> slots;        // Node order for the parallel passes
+    std::vector<size_t> owners;     // Partition of each node in slots
+    std::vector<Slot> partEntries;  // Entry point of each non-empty partition, as a slot here
+    std::vector<int> partLevels;    // ... and its top layer
+    std::vector<size_t> partOwners; // ... and its partition
+    for (size_t p = 0; p < parts.size(); p++) {
+        const HNSW& part = *parts[p];
+        if (part.store_.getDimension() != store_.getDimension()) {
+            throw std::invalid_argument("Partition dimension mismatch: expected " +
+                                        std::to_string(store_.getDimension()) + ", got " +
+                                        std::to_string(part.store_.getDimension()));
+        }
+        auto partIds = part.store_.ids();
+        renamed[p].resize(part.nodes_.size());
+        for (size_t s = 0; s < part.nodes_.size(); s++) {
+            if (!part.isIndexed(s)) {
+                continue;
+            }
+            VectorId id = partIds[s];
+            if (!store_.contains(id)) {
+                throw std::out_of_range("Partition vector not in store: " + std::to_string(id));
+            }
+            Slot slot = static_cast<Slot>(store_.slotOf(id));
+            if (merged[slot].topLayer >= 0) {
+                throw std::invalid_argument("Partitions overlap on ID " + std::to_string(id));
+            }
+            renamed[p][s] = slot;
+            merged[slot].topLayer = part.nodes_[s].topLayer;
+            slots.push_back(slot);
+            owners.push_back(p);
+        }
+        for (size_t s = 0; s < part.nodes_.size(); s++) {
+            if (!part.isIndexed(s)) {
+                continue;
+            }
+            const auto& lists = part.nodes_[s].neighbors;
+            auto& target = merged[renamed[p][s]].neighbors;
+            target.resize(lists.size());
+            for (size_t layer = 0; layer < lists.size(); layer++) {
+                for (Slot neighbor : lists[layer]) {
+                    target[layer].push_back(renamed[p][neighbor]);
+                }
+            }
+        }
+        if (part.maxLevel_ != -1) {
+            partEntries.push_back(renamed[p][part.entryPoint_]);
+            partLevels.push_back(part.maxLevel_);
+            partOwners.push_back(p);
+        }
+    }
+
+    // the union of the partition graphs is this index from here on; the
+    // cross-partition searches below only read it
+    nodes_.swap(merged);
+    maxLevel_ = -1;
+    for (size_t e = 0; e < partEntries.size(); e++) {
+        if (partLevels[e] > maxLevel_) {
+            maxLevel_ = partLevels[e];
+            entryPoint_ = partEntries[e];
+        }
+    }
+    generation_++;
+
+    // cross-partition candidates: one search per node and layer it sits
+    // on, over the union graph, seeded with the entry point of every other
+    // partition that reaches that layer. The seeds share one ef-bounded
+    // candidate list, so the work per node does not grow with the number
+    // of partitions. The node's own partition is never seeded and, without
+    // cross edges yet, cannot be reached.
+    size_t ef = std::max(efMerge, M_);
+    std::vector<std::vector<std::vector<ScoredSlot>>> found(slots.size());
+    pool.parallelFor(slots.size(), [&](size_t begin, size_t end) {
+        std::vector<Slot> seeds;
+        for (size_t i = begin; i < end; i++) {
+            int nodeLevel = nodes_[slots[i]].topLayer;
+            VectorView vec = store_.vectorAt(slots[i]);
+            found[i].resize(nodeLevel + 1);
+            for (int layer = nodeLevel; layer >= 0; layer--) {
+                seeds.clear();
+                for (size_t e = 0; e < partEntries.size(); e++) {
+                    if (partOwners[e] != owners[i] && partLevels[e] >= layer) {
+                        seeds.push_back(partEntries[e]);
+                    }
+                }
+                if (seeds.empty()) {
+                    continue;
+                }
+                found[i][layer] = searchLayer(vec, seeds, ef, layer);
+                found[i][layer].resize(std::min(M_, found[i][layer].size()));
+            }
+        }
+    });
+
+    std::vector<size_t> position(nodes_.size());  // Slot -> index in slots
+    for (size_t i = 0; i < slots.size(); i++) {
+        position[slots[i]] = i;
+    }
+
+    // each node keeps the M closest of its current neighbors, the nodes it
+    // found and the nodes that found it (found edges are offered both ways)
+    auto relink = [&]() {
+        // gathered sequentially, reverse offers land in other nodes' lists
+        std::vector<std::vector<std::vector<ScoredSlot>>> offered(slots.size());
+        for (size_t i = 0; i < slots.size(); i++) {
+            offered[i].resize(nodes_[slots[i]].neighbors.size());
+        }
+        for (size_t i = 0; i < slots.size(); i++) {
+            for (size_t layer = 0; layer < found[i].size(); layer++) {
+                for (const auto& [distance, slot] : found[i][layer]) {
+                    offered[i][layer].push_back({distance, slot});
+                    offered[position[slot]][layer].push_back({distance, slots[i]});
+                }
+            }
+        }
+
+        // only its own lists are written per node, so this is parallel
+        pool.parallelFor(slots.size(), [&](size_t begin, size_t end) {
+            std::vector<ScoredSlot> scored;
+            for (size_t i = begin; i < end; i++) {
+                HNSWNode& node = nodes_[slots[i]];
+                VectorView vec = store_.vectorAt(slots[i]);
+                for (size_t layer = 0; layer < node.neighbors.size(); layer++) {
+                    if (offered[i][layer].empty()) {
+                        continue;
+                    }
+                    scored.assign(offered[i][layer].begin(), offered[i][layer].end());
+                    for (auto n : node.neighbors[layer]) {
+                        scored.push_back({store_.cosineDistance(vec, store_.vectorAt(n)), n});
+                    }
+
+                    // a pair can be offered from both ends
+                    std::sort(scored.begin(), scored.end());
+                    auto& neighborList = node.neighbors[layer];
+                    neighborList.clear();
+                    for (size_t j = 0; j < scored.size() && neighborList.size() < M_; j++) {
+                        if (std::find(neighborList.begin(), neighborList.end(),
+                                      scored[j].second) == neighborList.end()) {
+                            neighborList.push_back(scored[j].second);
+                        }
+                    }
+                }
+            }
+        });
+    };
+    relink();
+
+    // refine layer 0 now that partitions are linked: one more search per
+    // node, from its own list, picks up neighbors of the new neighbors
+    pool.parallelFor(slots.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            auto near = searchLayer(store_.vectorAt(slots[i]), nodes_[slots[i]].neighbors[0], ef, 0);
+            near.erase(std::remove_if(near.begin(), near.end(),
+                                      [&](const ScoredSlot& c) { return c.second == slots[i]; }),
+                       near.end());
+            near.resize(std::min(M_, near.size()));
+            found[i].assign(1, std::move(near));
+        }
+    });
+    relink();
+}
+
+void HNSW::buildEntryPoints(size_t numCentroids, size_t numSeeds, size_t iterations) {
+    if (numCentroids == 0 || numSeeds == 0) {
+        throw std::invalid_argument("Entry point and seed counts must be greater than 0");
+    }
+    clearEntryPoints();
+    if (maxLevel_ == -1) {
+        return;
+    }
+
+    const size_t dim = store_.getDimension();
+
+    // k-means on a sample: a few hundred points per centroid is plenty
+    std::vector<Slot> sample;
+    sample.reserve(nodes_.size());
+    for (size_t slot = 0; slot < nodes_.size(); slot++) {
+        if (isIndexed(slot)) {
+            sample.push_back(static_cast<Slot>(slot));
+        }
+    }
+    std::shuffle(sample.begin(), sample.end(), rng_);
+    sample.resize(std::min(sample.size(), numCentroids * 256));
+    numCentroids = std::min(numCentroids, sample.size());
+
+    // k-means++ initialization: each new centroid is drawn with probability
+    // proportional to its squared distance from the closest one so far, so
+    // small well-separated clusters still get a centroid
+    std::vector<float> centroids(numCentroids * dim);
+    std::vector<double> closest(sample.size(), std::numeric_limits<double>::max());
+    size_t pick = 0;  // sample is already shuffled
+    for (size_t c = 0; c < numCentroids; c++) {
+        VectorView chosen = store_.vectorAt(sample[pick]);
+        std::copy(chosen.begin(), chosen.end(), centroids.begin() + c * dim);
+        double total = 0.0;
+        for (size_t i = 0; i < sample.size(); i++) {
+            double dist = store_.cosineDistance(store_.vectorAt(sample[i]), chosen);
+            closest[i] = std::min(closest[i], dist * dist);
+            total += closest[i];
+        }
+        if (total <= 0.0) {
+            // every sample point coincides with a centroid already
+            numCentroids = c + 1;
+            centroids.resize(numCentroids * dim);
+            break;
+        }
+        std::discrete_distribution<size_t> next(closest.begin(), closest.end());
+        pick = next(rng_);
+    }
+
+    std::vector<size_t> assignment(sample.size());
+    std::vector<size_t> counts(numCentroids);
+    for (size_t iter = 0; iter < iterations; iter++) {
+        for (size_t i = 0; i < sample.size(); i++) {
+            VectorView vec = store_.vectorAt(sample[i]);
+            float best = std::numeric_limits<float>::max();
+            for (size_t c = 0; c < numCentroids; c++) {
+                float dist = store_.cosineDistance(vec, VectorView(centroids.data() + c * dim, dim));
+                if (dist < best) {
+                    best = dist;
+                    assignment[i] = c;
+                }
+            }
+        }
+
+        // new centroid = mean of its members (only the direction matters for cosine)
+        std::fill(centroids.begin(), centroids.end(), 0.0f);
+        std::fill(counts.begin(), counts.end(), 0);
+        for (size_t i = 0; i < sample.size(); i++) {
+            VectorView vec = store_.vectorAt(sample[i]);
+            float* row = centroids.data() + assignment[i] * dim;
+            for (size_t j = 0; j < dim; j++) {
+                row[j] += vec[j];
+            }
+            counts[assignment[i]]++;
+        }
+        for (size_t c = 0; c < numCentroids; c++) {
+            if (counts[c] == 0) {
+                // empty cluster: restart it on a random sample point
+                VectorView vec = store_.vectorAt(sample[rng_() % sample.size()]);
+                std::copy(vec.begin(), vec.end(), centroids.begin() + c * dim);
+            }
+        }
+    }
+
+    // map each centroid to its nearest sampled node by a scan, not a graph
+    // search: a search could not leave the region the greedy descent reaches,
+    // which is exactly what the entry points are meant to fix
+    std::unordered_set<Slot> chosen;
+    for (size_t c = 0; c < numCentroids; c++) {
+        VectorView centroid(centroids.data() + c * dim, dim);
+        Slot nearest = sample[0];
+        float best = std::numeric_limits<float>::max();
+        for (Slot slot : sample) {
+            float dist = store_.cosineDistance(centroid, store_.vectorAt(slot));
+            if (dist < best) {
+                best = dist;
+                nearest = slot;
+            }
+        }
+        if (chosen.insert(nearest).second) {
+            VectorView vec = store_.vectorAt(nearest);
+            entryPoints_.push_back(nearest);
+            entryVectors_.insert(entryVectors_.end(), vec.begin(), vec.end());
+        }
+    }
+    entrySeeds_ = numSeeds;
+    generation_++;  // seeding changes search results
+}
+
+void HNSW::clearEntryPoints() {
+    entryPoints_.clear();
+    entryVectors_.clear();
+    entrySeeds_ = 0;
+    generation_++;
+}
+
+std::vector<HNSW::Slot> HNSW::baseLayerSeeds(VectorView query) const {
+    if (entryPoints_.empty()) {
+        return {descendToBaseLayer(query)};
+    }
+
+    // linear scan over the contiguous entry vectors
+    const size_t dim = store_.getDimension();
+    std::vector<ScoredSlot> scored(entryPoints_.size());
+    for (size_t i = 0; i < entryPoints_.size(); i++) {
+        scored[i] = {store_.cosineDistance(query, VectorView(entryVectors_.data() + i * dim, dim)),
+                     entryPoints_[i]};
+    }
+
+    size_t numSeeds = std::min(entrySeeds_, scored.size());
+    std::partial_sort(scored.begin(), scored.begin() + numSeeds, scored.end());
+    std::vector<Slot> seeds(numSeeds);
+    for (size_t i = 0; i < numSeeds; i++) {
+        seeds[i] = scored[i].second;
+    }
+    return seeds;
+}
+
+HNSW::Slot HNSW::descendToBaseLayer(VectorView query) const {
+    Slot currNode = entryPoint_;
+    for (int layer = maxLevel_; layer > 0; layer--) {
+        auto nearest = searchLayer(query, {currNode}, 1, layer);
+        if (!nearest.empty()) {
+            currNode = nearest[0].second;
+        }
+    }
+    return currNode;
+}
+
+void HNSW::validateQuery(VectorView query) const {
+    // distance kernels read store-dimension floats from the query
+    if (query.size() != store_.getDimension()) {
+        throw std::invalid_argument("Query dimension mismatch: expected " +
+                                    std::to_string(store_.getDimension()) + ", got " +
+                                    std::to_string(query.size()));
+    }
 }
 
 int HNSW::selectLevel() {
@@ -130,27 +730,53 @@ int HNSW::selectLevel() {
     return static_cast<int>(-log(r) * mL_);
 }
 
-std::vector<VectorWithDistance> HNSW::searchLayer(
-    const Vector& query,
-    const std::vector<VectorId>& entryPoints,
+std::vector<VectorWithDistance> HNSW::toResults(const std::vector<ScoredSlot>& found) const {
+    auto ids = store_.ids();
+    std::vector<VectorWithDistance> results;
+    results.reserve(found.size());
+    for (const auto& [distance, slot] : found) {
+        results.push_back({ids[slot], distance});
+    }
+    return results;
+}
+
+std::vector<HNSW::ScoredSlot> HNSW::searchLayer(
+    VectorView query,
+    const std::vector<Slot>& entryPoints,
     size_t numToReturn,
-    int layer) {
+    int layer,
+    SearchContext* ctx) const {
     
-    std::unordered_set<VectorId> visited;
-    std::priority_queue<std::pair<double, VectorId>, 
-                        std::vector<std::pair<double, VectorId>>, 
-                        std::greater<std::pair<double, VectorId>>> candidates;  // Min-heap
-    std::priority_queue<std::pair<double, VectorId>> results;  // Max-heap
+    VisitedSlots& visited = visitedSlots;
+    visited.reset(nodes_.size());
+    std::priority_queue<ScoredSlot, std::vector<ScoredSlot>,
+                        std::greater<ScoredSlot>> candidates;  // Min-heap
+    std::priority_queue<ScoredSlot> results;  // Max-heap
+
+    // adaptive mode: track the current top-k separately so we can tell
+    // whether an expansion improved it (patience only applies at layer 0)
+    bool usePatience = ctx && layer == 0 && ctx->budget.patience > 0;
+    std::priority_queue<float> topK;  // Max-heap of the best k distances
+    size_t sinceImprovement = 0;
 
     // initialize with entry points
     for(auto ep : entryPoints){
-        const Vector& epVec = store_.getVector(ep);
-        float similarity = cosineSimilarity(query, epVec);
-        double dist = 1.0 - similarity;
+        VectorView epVec = store_.vectorAt(ep);
+        float dist = store_.cosineDistance(query, epVec);
         
         candidates.push({dist, ep});
         results.push({dist, ep});
         visited.insert(ep);
+
+        if(ctx){
+            ctx->stats.distanceComputations++;
+        }
+        if(usePatience){
+            topK.push(dist);
+            if(topK.size() > ctx->k){
+                topK.pop();
+            }
+        }
     }
 
     // Main search loop
@@ -163,14 +789,35 @@ std::vector<VectorWithDistance> HNSW::searchLayer(
             break;
         }
 
+        // adaptive mode: stop on hard budget before doing more work
+        if(ctx){
+            if(ctx->exhausted()){
+                break;
+            }
+            ctx->stats.expansions++;
+        }
+        bool improved = false;
+
         // explore neighbors of current node at this layer
         for(auto neighbor : nodes_[curr.second].neighbors[layer]){
-            if(visited.find(neighbor) == visited.end()){
-                const Vector& neighborVec = store_.getVector(neighbor);
-                float similarity = cosineSimilarity(query, neighborVec);
-                double dist = 1.0 - similarity;
+            if(!visited.contains(neighbor)){
+                if(ctx && ctx->distanceCapReached()){
+                    break;
+                }
+                VectorView neighborVec = store_.vectorAt(neighbor);
+                float dist = store_.cosineDistance(query, neighborVec);
                 
                 visited.insert(neighbor);
+                if(ctx){
+                    ctx->stats.distanceComputations++;
+                }
+                if(usePatience && (topK.size() < ctx->k || dist < topK.top())){
+                    topK.push(dist);
+                    if(topK.size() > ctx->k){
+                        topK.pop();
+                    }
+                    improved = true;
+                }
                 
                 // add to results if good enough
                 if(results.size() < numToReturn || dist < results.top().first){
@@ -184,14 +831,22 @@ std::vector<VectorWithDistance> HNSW::searchLayer(
                 }
             }
         }
+
+        // adaptive mode: give up once the top-k has been stable for a while
+        if(usePatience){
+            sinceImprovement = improved ? 0 : sinceImprovement + 1;
+            if(sinceImprovement >= ctx->budget.patience){
+                ctx->stats.converged = true;
+                break;
+            }
+        }
     }
     
     // convert heap to vector and return (closest first)
-    std::vector<VectorWithDistance> result;
+    std::vector<ScoredSlot> result;
     while (!results.empty()) {
-        auto top = results.top();
+        result.push_back(results.top());
         results.pop();
-        result.push_back({top.second, static_cast<float>(top.first)});
     }
     std::reverse(result.begin(), result.end());  // reverse to get closest first
     return result;
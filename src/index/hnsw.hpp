@@ -3,12 +3,41 @@
 #include "../common/types.hpp"
 #include "../common/vector_store.hpp"
 #include <vector>
-#include <unordered_map>
+#include <cstdint>
 #include <random>
 #include <cmath>
+#include <atomic>
+#include <chrono>
 
 namespace atlas {
 
+class ThreadPool;
+
+/**
+ * Budget for adaptive (early-terminating) search
+ *
+ * Every limit is optional: a zero value disables it. With all limits
+ * disabled the search behaves exactly like a fixed-ef search.
+ */
+struct SearchBudget {
+    size_t patience = 0;                     // Stop after this many expansions without a top-k improvement
+    size_t maxDistanceComputations = 0;      // Hard cap on distance evaluations for the whole query
+    std::chrono::microseconds maxTime{0};    // Wall-clock budget for the whole query
+    std::chrono::steady_clock::time_point deadline{};  // Absolute deadline (default = none)
+    const std::atomic<bool>* cancel = nullptr;         // Cooperative cancellation flag
+};
+
+/**
+ * Per-query statistics reported by adaptive search
+ */
+struct SearchStats {
+    size_t distanceComputations = 0;  // Distance evaluations across all layers
+    size_t expansions = 0;            // Candidates popped and expanded across all layers
+    bool converged = false;           // Stopped because the top-k stopped improving (patience)
+    bool truncated = false;           // Stopped because a hard budget (distance/time/deadline) was hit
+    bool cancelled = false;           // Stopped because the cancel flag was raised
+};
+
 /**
  * HNSW (Hierarchical Navigable Small World) Index
  * 
@@ -33,6 +62,9 @@ public:
      * Add a vector to the HNSW index
      * 
      * @param id VectorId that exists in the VectorStore
+     * @throws std::out_of_range if id is not in the store
+     * @throws std::invalid_argument if the vector has zero magnitude
+     *         (the index is left unchanged)
      * 
      * TODO Steps to implement:
      * 1. Select layer for this node using exponential decay
@@ -57,6 +89,135 @@ public:
      */
     std::vector<VectorWithDistance> search(const Vector& query, size_t k, size_t efSearch);
 
+    /**
+     * Search with a query that is not owned by a Vector (e.g. a row of a
+     * receive buffer or of the store), without copying it
+     */
+    std::vector<VectorWithDistance> search(VectorView query, size_t k, size_t efSearch);
+
+    /**
+     * Adaptive search with early termination
+     *
+     * Like search(), but the layer-0 expansion may stop before the ef
+     * candidate list converges: when the top-k has not improved for
+     * budget.patience expansions, or when the distance/time budget is
+     * exhausted. efSearch acts as the upper bound on work. A deadline or a
+     * raised cancel flag stops the search the same way, returning the best
+     * partial results found so far.
+     *
+     * @param query Query vector
+     * @param k Number of nearest neighbors to return
+     * @param efSearch Maximum size of the dynamic candidate list
+     * @param budget Early-termination limits (zero = disabled)
+     * @param stats Optional output: work done and why the search stopped
+     * @return Best k neighbors found within the budget
+     */
+    std::vector<VectorWithDistance> search(const Vector& query, size_t k, size_t efSearch,
+                                           const SearchBudget& budget,
+                                           SearchStats* stats = nullptr);
+
+    /**
+     * Range search: all vectors within a distance threshold
+     *
+     * Seeds layer 0 with an ordinary ef-bounded search, then keeps expanding
+     * the graph outward from every node that lies within the radius, until
+     * no unexpanded candidate is inside it. Unlike top-k search the result
+     * size is driven by the data, not by k.
+     *
+     * @param query Query vector
+     * @param radius Maximum cosine distance (1 - similarity) to include
+     * @param efSearch Candidate list size for the seeding search
+     * @return All matches found, sorted by distance ascending
+     */
+    RangeSearchResult rangeSearch(const Vector& query, Distance radius, size_t efSearch = 64);
+
+    /**
+     * Index generation, bumped by every graph modification and by
+     * building or clearing entry points
+     *
+     * Lets result caches detect that cached answers may be out of date.
+     */
+    uint64_t generation() const { return generation_; }
+
+    /**
+     * Compute a locality-friendly node order (reverse Cuthill-McKee on layer 0)
+     *
+     * Breadth-first from the entry point, visiting low-degree neighbors
+     * first, so nodes that are expanded together end up adjacent.
+     * Disconnected nodes are appended in their current store order.
+     *
+     * @return Every indexed ID exactly once, in the new order
+     */
+    std::vector<VectorId> localityOrder() const;
+
+    /**
+     * Offline reorder pass: lay out vectors and graph nodes in localityOrder()
+     *
+     * Permutes the VectorStore arena and rebuilds the slot-indexed node
+     * table (renumbering every adjacency list and copying it into a fresh
+     * buffer) in the same order, so graph neighbors and the lists
+     * searchLayer walks sit close in memory. IDs and search results are
+     * unchanged. Run after a build, not concurrently with searches.
+     *
+     * The graph refers to nodes by store slot, so while an index is built
+     * on a store, this is the only way that store may be reordered.
+     */
+    void reorderForLocality();
+
+    /**
+     * Merge independently built graphs over disjoint ID sets into this index
+     *
+     * Every partition's nodes keep their layers and intra-partition edges.
+     * The union of the partition graphs is then linked in two passes of
+     * independent per-node searches (parallel on the pool):
+     * 1. on every layer a node sits on, one search seeded with the entry
+     *    points of all other partitions, sharing one candidate list;
+     * 2. on layer 0, one search from the node's updated neighbor list,
+     *    which now crosses partitions, to find neighbors of neighbors.
+     * After each pass every adjacency list becomes the M closest of its old
+     * neighbors, the nodes it found and the nodes that found it. The entry
+     * point is the highest-level partition entry point.
+     *
+     * The work is about 2 * N searches of efMerge for any number of
+     * partitions. With one thread (bench_micro, 5000 x 128, M 16), a merge
+     * costs roughly 0.5x-0.75x a full efConstruction-100 rebuild at 2
+     * to 16 partitions. Search recall@10 (ef 64, random vectors) matches
+     * the rebuild at 2 and 4 partitions and is 0.01-0.04 lower at 8 and 16.
+     *
+     * @param parts Partition graphs; only read, may use other VectorStores
+     *              as long as their IDs are in this index's store
+     * @param pool Executor for the cross-partition searches
+     * @param efMerge Candidate list size of each merge search
+     * @throws std::invalid_argument if this index is not empty, a partition
+     *         has a different dimension or two partitions share an ID
+     * @throws std::out_of_range if a partition ID is not in this index's store
+     */
+    void merge(const std::vector<const HNSW*>& parts, ThreadPool& pool, size_t efMerge = 32);
+
+    /**
+     * Precompute layer-0 entry points for clustered data
+     *
+     * Runs k-means (k-means++ initialization, cosine assignment) over a
+     * sample of the indexed vectors and maps each centroid to its nearest
+     * sampled node. From then on, searches skip
+     * the upper-layer descent: each query scans the entry vectors (kept
+     * contiguous, so the scan is a tight sequential kernel loop) and seeds
+     * the layer-0 search with the numSeeds closest. Entry points stay valid
+     * across inserts; rebuild them after the data distribution shifts.
+     *
+     * @param numCentroids Number of k-means centroids (entry points)
+     * @param numSeeds Entry points used to seed each query
+     * @param iterations k-means (Lloyd) iterations
+     * @throws std::invalid_argument if numCentroids or numSeeds is 0
+     */
+    void buildEntryPoints(size_t numCentroids, size_t numSeeds = 4, size_t iterations = 10);
+
+    // Drop the precomputed entry points (back to the greedy descent)
+    void clearEntryPoints();
+
+    // Number of precomputed entry points (0 = greedy descent)
+    size_t numEntryPoints() const { return entryPoints_.size(); }
+
 private:
     // Reference to the vector storage
     VectorStore& store_;
@@ -70,28 +231,87 @@ private:
     std::mt19937 rng_;
     std::uniform_real_distribution<double> uniform_dist_;
     
-    // TODO: Design the node structure
+    // Nodes are named by their VectorStore slot, not their ID: the node
+    // table and adjacency lists are plain arrays indexed by slot, and the
+    // vector of a neighbor is read with store_.vectorAt() without a hash
+    // lookup. IDs only appear at the API boundary.
+    using Slot = uint32_t;
+    using ScoredSlot = std::pair<float, Slot>;  // (distance, slot), sorts closest first
+
     struct HNSWNode{
         int topLayer;
 
-        std::vector<std::vector<VectorId>> neighbors;
+        std::vector<std::vector<Slot>> neighbors;
 
-        // Default constructor
-        HNSWNode() : topLayer(0), neighbors(1) {}
+        // Default constructor: a store slot that is not indexed
+        HNSWNode() : topLayer(-1) {}
         
         // Constructor with layer
         HNSWNode(int layer) : topLayer(layer), neighbors(layer + 1){}
     };
     
-    std::unordered_map<VectorId, HNSWNode> nodes_;
-    VectorId entryPoint_;   // Entry point for search (node with highest layer)
+    std::vector<HNSWNode> nodes_;  // Indexed by store slot; may be shorter than the store
+    Slot entryPoint_;       // Entry point for search (node with highest layer)
     int maxLevel_;          // Current maximum layer in the graph
+    uint64_t generation_;   // Incremented on every change to search results
+
+    // Optional layer-0 entry points (see buildEntryPoints)
+    std::vector<Slot> entryPoints_;      // Graph nodes nearest the k-means centroids
+    std::vector<float> entryVectors_;    // Their vectors, one contiguous row each
+    size_t entrySeeds_;                  // Entry points used per query
     
     /**
      * Randomly select the top layer for a new node
      * Uses exponential decay: P(level = l) ~ (1/M)^l
      */
     int selectLevel();
+
+    // True if the slot holds an indexed node
+    bool isIndexed(size_t slot) const {
+        return slot < nodes_.size() && nodes_[slot].topLayer >= 0;
+    }
+
+    // Translate slot results to (ID, distance) pairs for the caller
+    std::vector<VectorWithDistance> toResults(const std::vector<ScoredSlot>& found) const;
+
+    // localityOrder() over indexed slots
+    std::vector<Slot> localitySlotOrder() const;
+
+    /**
+     * Reject queries whose dimension differs from the store's
+     * @throws std::invalid_argument on mismatch
+     */
+    void validateQuery(VectorView query) const;
+
+    /**
+     * Greedy (ef=1) descent from the entry point down to layer 1
+     * @return The node to start the layer-0 search from
+     */
+    Slot descendToBaseLayer(VectorView query) const;
+
+    /**
+     * Starting points for the layer-0 search: the closest precomputed entry
+     * points if any, otherwise the result of the greedy descent
+     */
+    std::vector<Slot> baseLayerSeeds(VectorView query) const;
+
+    /**
+     * Bookkeeping shared by every searchLayer call of one adaptive query
+     */
+    struct SearchContext {
+        const SearchBudget& budget;
+        SearchStats& stats;
+        size_t k;                                        // Size of the top-k tracked for patience
+        bool hasDeadline;                                // maxTime or deadline set
+        std::chrono::steady_clock::time_point deadline;  // Earliest of start + maxTime and budget.deadline
+
+        // True once the distance budget is spent (records truncation in stats)
+        bool distanceCapReached();
+
+        // True once any hard budget (distance, time, deadline) is spent or the
+        // query was cancelled; reads the clock
+        bool exhausted();
+    };
     
     /**
      * Search for nearest neighbors within a single layer
@@ -103,14 +323,16 @@ private:
      * @param entryPoints Starting points for search in this layer
      * @param numToReturn How many closest neighbors to return
      * @param layer Which layer to search in
-     * @return Closest neighbors found in this layer
+     * @param ctx Adaptive search state, or nullptr for a plain fixed-ef search
+     * @return Closest neighbors found in this layer, closest first
      */
-    std::vector<VectorWithDistance> searchLayer(
-        const Vector& query,
-        const std::vector<VectorId>& entryPoints,
+    std::vector<ScoredSlot> searchLayer(
+        VectorView query,
+        const std::vector<Slot>& entryPoints,
         size_t numToReturn,
-        int layer
-    );
+        int layer,
+        SearchContext* ctx = nullptr
+    ) const;
 };
 
 } // namespace atlas
@@ -0,0 +1,146 @@
+#include "query_cache.hpp"
+#include "hnsw.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace atlas {
+
+QueryCache::QueryCache(size_t capacity, size_t numShards, float quantizationStep)
+    : quantizationStep_(quantizationStep) {
+    if (capacity == 0 || numShards == 0) {
+        throw std::invalid_argument("Cache capacity and shard count must be greater than 0");
+    }
+    if (!(quantizationStep > 0.0f)) {
+        throw std::invalid_argument("Quantization step must be positive");
+    }
+
+    numShards = std::min(numShards, capacity);
+    shardCapacity_ = (capacity + numShards - 1) / numShards;
+    for (size_t i = 0; i < numShards; i++) {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+}
+
+QueryCache::Key QueryCache::makeKey(const Vector& query, size_t k, size_t efSearch) const {
+    Key key{{}, k, efSearch, 0};
+    key.cells.reserve(query.size());
+
+    // FNV-1a over the quantized cells, then k and ef
+    uint64_t h = 1469598103934665603ULL;
+    auto mix = [&h](uint64_t v) {
+        h ^= v;
+        h *= 1099511628211ULL;
+    };
+    for (float value : query) {
+        int32_t cell = static_cast<int32_t>(std::lround(value / quantizationStep_));
+        key.cells.push_back(cell);
+        mix(static_cast<uint32_t>(cell));
+    }
+    mix(k);
+    mix(efSearch);
+    key.hash = static_cast<size_t>(h);
+    return key;
+}
+
+QueryCache::Shard& QueryCache::shardFor(const Key& key) {
+    // high bits pick the shard, low bits are left for the shard's buckets
+    return *shards_[(static_cast<uint64_t>(key.hash) >> 32) % shards_.size()];
+}
+
+bool QueryCache::lookup(const Vector& query, size_t k, size_t efSearch,
+                        uint64_t generation, std::vector<VectorWithDistance>& out) {
+    Key key = makeKey(query, k, efSearch);
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        shard.stats.misses++;
+        return false;
+    }
+
+    // computed against an older graph: drop it
+    if (it->second->generation != generation) {
+        shard.lru.erase(it->second);
+        shard.index.erase(it);
+        shard.stats.misses++;
+        shard.stats.stale++;
+        return false;
+    }
+
+    // move to front (most recently used)
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    out = it->second->results;
+    shard.stats.hits++;
+    return true;
+}
+
+void QueryCache::insert(const Vector& query, size_t k, size_t efSearch,
+                        uint64_t generation, std::vector<VectorWithDistance> results) {
+    Key key = makeKey(query, k, efSearch);
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        it->second->generation = generation;
+        it->second->results = std::move(results);
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return;
+    }
+
+    shard.lru.push_front(Entry{key, generation, std::move(results)});
+    shard.index.emplace(std::move(key), shard.lru.begin());
+
+    // evict least recently used
+    while (shard.lru.size() > shardCapacity_) {
+        shard.index.erase(shard.lru.back().key);
+        shard.lru.pop_back();
+        shard.stats.evictions++;
+    }
+}
+
+std::vector<VectorWithDistance> QueryCache::search(HNSW& index, const Vector& query,
+                                                   size_t k, size_t efSearch) {
+    uint64_t generation = index.generation();
+    std::vector<VectorWithDistance> results;
+    if (lookup(query, k, efSearch, generation, results)) {
+        return results;
+    }
+
+    results = index.search(query, k, efSearch);
+    insert(query, k, efSearch, generation, results);
+    return results;
+}
+
+void QueryCache::clear() {
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->lru.clear();
+        shard->index.clear();
+    }
+}
+
+size_t QueryCache::size() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        total += shard->lru.size();
+    }
+    return total;
+}
+
+QueryCacheStats QueryCache::stats() const {
+    QueryCacheStats total;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        total.hits += shard->stats.hits;
+        total.misses += shard->stats.misses;
+        total.stale += shard->stats.stale;
+        total.evictions += shard->stats.evictions;
+    }
+    return total;
+}
+
+} // namespace atlas
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "../common/types.hpp"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+
+class HNSW;
+
+/**
+ * Hit/miss counters for QueryCache (summed over all shards)
+ */
+struct QueryCacheStats {
+    uint64_t hits = 0;       // Lookups answered from the cache
+    uint64_t misses = 0;     // Lookups that had to run the search
+    uint64_t stale = 0;      // Misses caused by an index generation change
+    uint64_t evictions = 0;  // Entries dropped to stay within capacity
+
+    double hitRate() const {
+        uint64_t total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+    }
+};
+
+/**
+ * Sharded, thread-safe LRU cache of search results
+ *
+ * Keys are the query quantized to a grid of `quantizationStep`, plus k and
+ * ef, so exact repeats and near-duplicates that round to the same grid
+ * cell share one entry. Each entry remembers the index generation it was
+ * computed at; after an insert bumps HNSW::generation() old entries are
+ * treated as misses and replaced lazily.
+ */
+class QueryCache {
+public:
+    /**
+     * Constructor
+     *
+     * @param capacity Maximum number of cached queries (split across shards)
+     * @param numShards Independent LRU shards, each with its own lock
+     * @param quantizationStep Grid size for query components (larger = more
+     *        near-duplicates collapse onto one entry, less exact results)
+     */
+    explicit QueryCache(size_t capacity, size_t numShards = 16,
+                        float quantizationStep = 1e-4f);
+
+    /**
+     * Look up cached results
+     *
+     * @param query Query vector
+     * @param k Number of neighbors requested
+     * @param efSearch Candidate list size requested
+     * @param generation Current index generation
+     * @param out Receives the cached results on a hit
+     * @return true on a hit
+     */
+    bool lookup(const Vector& query, size_t k, size_t efSearch,
+                uint64_t generation, std::vector<VectorWithDistance>& out);
+
+    /**
+     * Store results for a query (replaces any existing entry)
+     */
+    void insert(const Vector& query, size_t k, size_t efSearch,
+                uint64_t generation, std::vector<VectorWithDistance> results);
+
+    /**
+     * Cached front end for HNSW::search
+     *
+     * Returns cached results if present for the index's current
+     * generation, otherwise runs the search and caches its results.
+     */
+    std::vector<VectorWithDistance> search(HNSW& index, const Vector& query,
+                                           size_t k, size_t efSearch);
+
+    // Drop every entry (counters are kept)
+    void clear();
+
+    // Number of cached entries
+    size_t size() const;
+
+    // Snapshot of the counters
+    QueryCacheStats stats() const;
+
+private:
+    struct Key {
+        std::vector<int32_t> cells;  // Quantized query
+        size_t k;
+        size_t efSearch;
+        size_t hash;
+
+        bool operator==(const Key& other) const {
+            return hash == other.hash && k == other.k &&
+                   efSearch == other.efSearch && cells == other.cells;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const { return key.hash; }
+    };
+
+    struct Entry {
+        Key key;
+        uint64_t generation;
+        std::vector<VectorWithDistance> results;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<Entry> lru;  // Most recently used first
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+        QueryCacheStats stats;
+    };
+
+    Key makeKey(const Vector& query, size_t k, size_t efSearch) const;
+    Shard& shardFor(const Key& key);
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    size_t shardCapacity_;
+    float quantizationStep_;
+};
+
+} // namespace atlas
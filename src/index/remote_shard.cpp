@@ -0,0 +1,227 @@
+#include "remote_shard.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <sys/socket.h>
+
+namespace atlas {
+
+namespace {
+
+// Request opcodes
+enum : uint8_t { kOpAdd = 1, kOpSearch = 2, kOpSize = 3 };
+
+// Response status
+enum : uint8_t { kStatusOk = 0, kStatusError = 1 };
+
+// Largest array a request may announce; anything bigger is a corrupt or
+// hostile stream, and the connection is dropped rather than resynchronized
+constexpr uint64_t kMaxRequestBytes = uint64_t(256) << 20;
+
+// Validate an announced element count before allocating for it
+template <typename T>
+size_t checkedCount(uint64_t count) {
+    if (count > kMaxRequestBytes / sizeof(T)) {
+        throw std::runtime_error("Shard request too large: " + std::to_string(count) +
+                                 " elements");
+    }
+    return static_cast<size_t>(count);
+}
+
+template <typename T>
+void writeValue(int fd, const T& value) {
+    writeAll(fd, &value, sizeof(T));
+}
+
+template <typename T>
+T readValue(int fd) {
+    T value;
+    readAll(fd, &value, sizeof(T));
+    return value;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Client side
+// ---------------------------------------------------------------------------
+
+RemoteShard::RemoteShard(const std::string& socketPath) : conn_(connectUnix(socketPath)) {}
+
+void RemoteShard::checkStatus() {
+    uint8_t status = readValue<uint8_t>(conn_.get());
+    if (status == kStatusOk) {
+        return;
+    }
+    uint32_t len = readValue<uint32_t>(conn_.get());
+    std::string message(len, '\0');
+    readAll(conn_.get(), message.data(), len);
+    throw std::runtime_error("Remote shard error: " + message);
+}
+
+void RemoteShard::addVectors(std::span<const VectorId> ids, std::span<const float> data) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int fd = conn_.get();
+    writeValue<uint8_t>(fd, kOpAdd);
+    writeValue<uint64_t>(fd, ids.size());
+    writeValue<uint64_t>(fd, data.size());
+    writeAll(fd, ids.data(), ids.size_bytes());
+    writeAll(fd, data.data(), data.size_bytes());
+    checkStatus();
+}
+
+std::vector<VectorWithDistance> RemoteShard::search(const Vector& query, size_t k,
+                                                    size_t efSearch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int fd = conn_.get();
+    writeValue<uint8_t>(fd, kOpSearch);
+    writeValue<uint32_t>(fd, static_cast<uint32_t>(k));
+    writeValue<uint32_t>(fd, static_cast<uint32_t>(efSearch));
+    writeValue<uint32_t>(fd, static_cast<uint32_t>(query.size()));
+    writeAll(fd, query.data(), query.size() * sizeof(float));
+    checkStatus();
+
+    uint32_t count = readValue<uint32_t>(fd);
+    std::vector<VectorWithDistance> results(count);
+    for (auto& result : results) {
+        result.id = readValue<VectorId>(fd);
+        result.distance = readValue<Distance>(fd);
+    }
+    return results;
+}
+
+size_t RemoteShard::size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    writeValue<uint8_t>(conn_.get(), kOpSize);
+    checkStatus();
+    return readValue<uint64_t>(conn_.get());
+}
+
+// ---------------------------------------------------------------------------
+// Server side
+// ---------------------------------------------------------------------------
+
+ShardServer::ShardServer(std::unique_ptr<IndexShard> shard, const std::string& socketPath)
+    : shard_(std::move(shard)),
+      socketPath_(socketPath),
+      listener_(listenUnix(socketPath)),
+      stopping_(false),
+      acceptThread_(&ShardServer::acceptLoop, this) {}
+
+ShardServer::~ShardServer() {
+    stopping_ = true;
+
+    // wake the blocked accept() and every blocked read()
+    ::shutdown(listener_.get(), SHUT_RDWR);
+    acceptThread_.join();
+    {
+        std::lock_guard<std::mutex> lock(connMutex_);
+        for (int fd : connections_) {
+            ::shutdown(fd, SHUT_RDWR);
+        }
+    }
+    for (auto& [id, worker] : workers_) {
+        worker.join();
+    }
+    ::unlink(socketPath_.c_str());
+}
+
+void ShardServer::acceptLoop() {
+    while (!stopping_) {
+        int fd = ::accept4(listener_.get(), nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED || stopping_) {
+                continue;
+            }
+            // persistent errors (EMFILE, ENFILE, ENOBUFS) would busy-spin:
+            // give closing connections time to free resources
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(connMutex_);
+        if (stopping_) {
+            FileDescriptor closeNow(fd);
+            return;
+        }
+
+        // reap threads of connections that have closed since the last accept
+        for (std::thread::id id : finished_) {
+            auto it = workers_.find(id);
+            it->second.join();
+            workers_.erase(it);
+        }
+        finished_.clear();
+
+        connections_.push_back(fd);
+        std::thread worker(&ShardServer::serve, this, fd);
+        std::thread::id id = worker.get_id();
+        workers_.emplace(id, std::move(worker));
+    }
+}
+
+void ShardServer::serve(int fd) {
+    FileDescriptor conn(fd);
+    std::vector<VectorId> ids;
+    std::vector<float> data;
+    Vector query;
+
+    try {
+        while (true) {
+            uint8_t op = readValue<uint8_t>(fd);
+            try {
+                if (op == kOpAdd) {
+                    ids.resize(checkedCount<VectorId>(readValue<uint64_t>(fd)));
+                    data.resize(checkedCount<float>(readValue<uint64_t>(fd)));
+                    readAll(fd, ids.data(), ids.size() * sizeof(VectorId));
+                    readAll(fd, data.data(), data.size() * sizeof(float));
+                    std::unique_lock<std::shared_mutex> lock(shardMutex_);
+                    shard_->addVectors(ids, data);
+                    writeValue<uint8_t>(fd, kStatusOk);
+                } else if (op == kOpSearch) {
+                    uint32_t k = readValue<uint32_t>(fd);
+                    uint32_t efSearch = readValue<uint32_t>(fd);
+                    query.resize(checkedCount<float>(readValue<uint32_t>(fd)));
+                    readAll(fd, query.data(), query.size() * sizeof(float));
+                    std::vector<VectorWithDistance> results;
+                    {
+                        std::shared_lock<std::shared_mutex> lock(shardMutex_);
+                        results = shard_->search(query, k, efSearch);
+                    }
+                    writeValue<uint8_t>(fd, kStatusOk);
+                    writeValue<uint32_t>(fd, static_cast<uint32_t>(results.size()));
+                    for (const auto& result : results) {
+                        writeValue(fd, result.id);
+                        writeValue(fd, result.distance);
+                    }
+                } else if (op == kOpSize) {
+                    uint64_t size;
+                    {
+                        std::shared_lock<std::shared_mutex> lock(shardMutex_);
+                        size = shard_->size();
+                    }
+                    writeValue<uint8_t>(fd, kStatusOk);
+                    writeValue<uint64_t>(fd, size);
+                } else {
+                    throw std::runtime_error("Unknown shard opcode " + std::to_string(op));
+                }
+            } catch (const std::logic_error& e) {
+                // bad request (e.g. dimension mismatch): report and keep serving
+                std::string message = e.what();
+                writeValue<uint8_t>(fd, kStatusError);
+                writeValue<uint32_t>(fd, static_cast<uint32_t>(message.size()));
+                writeAll(fd, message.data(), message.size());
+            }
+        }
+    } catch (const std::exception&) {
+        // peer closed or I/O failed: drop the connection
+    }
+
+    std::lock_guard<std::mutex> lock(connMutex_);
+    std::erase(connections_, fd);
+    if (!stopping_) {
+        finished_.push_back(std::this_thread::get_id());
+    }
+}
+
+} // namespace atlas
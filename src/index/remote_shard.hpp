@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../net/socket.hpp"
+#include "sharded_index.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * RemoteShard - IndexShard proxy that talks to a ShardServer
+ *
+ * Stand-in for a shard living on another node: requests go over a Unix
+ * domain socket with a small length-prefixed binary framing (host byte
+ * order, same machine). One connection per proxy; calls are serialized.
+ */
+class RemoteShard : public IndexShard {
+public:
+    /**
+     * Connect to a ShardServer
+     * @param socketPath Path the server listens on
+     * @throws std::runtime_error if the connection fails
+     */
+    explicit RemoteShard(const std::string& socketPath);
+
+    void addVectors(std::span<const VectorId> ids, std::span<const float> data) override;
+    std::vector<VectorWithDistance> search(const Vector& query, size_t k,
+                                           size_t efSearch) override;
+    size_t size() override;
+
+private:
+    // Read the status byte; throws the server's message on error
+    void checkStatus();
+
+    FileDescriptor conn_;
+    std::mutex mutex_;
+};
+
+/**
+ * ShardServer - Serves one IndexShard on a Unix domain socket
+ *
+ * Runs an accept loop on a background thread and one thread per client
+ * connection. Threads of closed connections are joined by the accept loop
+ * at the next accept; the rest are stopped and joined on destruction.
+ */
+class ShardServer {
+public:
+    /**
+     * Start serving
+     * @param shard Shard to serve (owned by the server)
+     * @param socketPath Path to listen on (an existing socket file is replaced)
+     */
+    ShardServer(std::unique_ptr<IndexShard> shard, const std::string& socketPath);
+    ~ShardServer();
+
+    ShardServer(const ShardServer&) = delete;
+    ShardServer& operator=(const ShardServer&) = delete;
+
+private:
+    void acceptLoop();
+    void serve(int fd);
+
+    std::unique_ptr<IndexShard> shard_;
+    std::string socketPath_;
+    FileDescriptor listener_;
+    std::atomic<bool> stopping_;
+    std::shared_mutex shardMutex_;  // Searches shared, inserts exclusive
+    std::mutex connMutex_;          // Guards connections_ / workers_ / finished_
+    std::vector<int> connections_;
+    std::unordered_map<std::thread::id, std::thread> workers_;
+    std::vector<std::thread::id> finished_;  // Workers that returned, not yet joined
+    std::thread acceptThread_;
+};
+
+} // namespace atlas
@@ -0,0 +1,176 @@
+#include "sharded_index.hpp"
+#include "../distance/distance.hpp"
+#include <algorithm>
+#include <future>
+#include <stdexcept>
+#include <string>
+
+namespace atlas {
+
+LocalShard::LocalShard(size_t dimension, size_t M, size_t efConstruction)
+    : store_(dimension), index_(store_, M, efConstruction) {}
+
+void LocalShard::addVectors(std::span<const VectorId> ids, std::span<const float> data) {
+    // reject zero rows before anything is stored: the index refuses them
+    // only after the store has taken the whole batch (the store itself
+    // reports a size mismatch and checks the IDs)
+    const size_t dim = store_.getDimension();
+    if (data.size() == ids.size() * dim) {
+        for (size_t row = 0; row < ids.size(); row++) {
+            if (isZeroMagnitude(data.subspan(row * dim, dim))) {
+                throw std::invalid_argument("Vector " + std::to_string(ids[row]) +
+                                            " has zero magnitude");
+            }
+        }
+    }
+    store_.addVectors(ids, data);
+    for (VectorId id : ids) {
+        index_.addVector(id);
+    }
+}
+
+std::vector<VectorWithDistance> LocalShard::search(const Vector& query, size_t k,
+                                                   size_t efSearch) {
+    return index_.search(query, k, efSearch);
+}
+
+size_t LocalShard::size() { return store_.size(); }
+
+ShardedIndex::ShardedIndex(size_t dimension, const ShardedIndexOptions& options)
+    : dimension_(dimension),
+      options_(options),
+      pool_(options.numThreads > 0 ? options.numThreads : std::max<size_t>(options.numShards, 1)) {
+    validateOptions();
+    for (size_t i = 0; i < options_.numShards; i++) {
+        shards_.push_back(std::make_unique<LocalShard>(dimension, options_.M,
+                                                       options_.efConstruction));
+    }
+}
+
+ShardedIndex::ShardedIndex(size_t dimension, std::vector<std::unique_ptr<IndexShard>> shards,
+                           const ShardedIndexOptions& options)
+    : dimension_(dimension),
+      options_(options),
+      shards_(std::move(shards)),
+      pool_(options.numThreads > 0 ? options.numThreads : std::max<size_t>(shards_.size(), 1)) {
+    options_.numShards = shards_.size();
+    validateOptions();
+}
+
+void ShardedIndex::validateOptions() const {
+    if (dimension_ == 0) {
+        throw std::invalid_argument("Dimension must be greater than 0");
+    }
+    if (options_.numShards == 0) {
+        throw std::invalid_argument("Shard count must be greater than 0");
+    }
+    if (options_.scheme == PartitionScheme::Range) {
+        const auto& splits = options_.rangeSplits;
+        if (splits.size() != options_.numShards - 1) {
+            throw std::invalid_argument("Range partitioning needs " +
+                                        std::to_string(options_.numShards - 1) +
+                                        " split points, got " + std::to_string(splits.size()));
+        }
+        if (!std::is_sorted(splits.begin(), splits.end())) {
+            throw std::invalid_argument("Range split points must be ascending");
+        }
+    }
+}
+
+size_t ShardedIndex::shardFor(VectorId id) const {
+    if (options_.scheme == PartitionScheme::Range) {
+        const auto& splits = options_.rangeSplits;
+        return std::upper_bound(splits.begin(), splits.end(), id) - splits.begin();
+    }
+
+    // splitmix64 finalizer so sequential IDs spread evenly
+    uint64_t h = id + 0x9e3779b97f4a7c15ULL;
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h % shards_.size();
+}
+
+void ShardedIndex::addVector(VectorId id, const Vector& vec) {
+    if (vec.size() != dimension_) {
+        throw std::invalid_argument("Vector dimension mismatch: expected " +
+                                    std::to_string(dimension_) + ", got " +
+                                    std::to_string(vec.size()));
+    }
+    VectorId ids[1] = {id};
+    shards_[shardFor(id)]->addVectors(ids, vec);
+}
+
+void ShardedIndex::build(std::span<const VectorId> ids, std::span<const float> data) {
+    if (data.size() != ids.size() * dimension_) {
+        throw std::invalid_argument("Batch size mismatch: expected " +
+                                    std::to_string(ids.size() * dimension_) +
+                                    " floats, got " + std::to_string(data.size()));
+    }
+
+    // partition rows per shard
+    std::vector<std::vector<VectorId>> shardIds(shards_.size());
+    std::vector<std::vector<float>> shardData(shards_.size());
+    for (size_t row = 0; row < ids.size(); row++) {
+        size_t shard = shardFor(ids[row]);
+        shardIds[shard].push_back(ids[row]);
+        auto rowData = data.subspan(row * dimension_, dimension_);
+        shardData[shard].insert(shardData[shard].end(), rowData.begin(), rowData.end());
+    }
+
+    // build every shard concurrently
+    std::vector<std::future<void>> pending;
+    for (size_t shard = 0; shard < shards_.size(); shard++) {
+        if (shardIds[shard].empty()) {
+            continue;
+        }
+        pending.push_back(pool_.submit([this, shard, &shardIds, &shardData]() {
+            shards_[shard]->addVectors(shardIds[shard], shardData[shard]);
+        }));
+    }
+
+    // wait for all before rethrowing so no task outlives the partitions
+    ThreadPool::waitAll(pending);
+}
+
+std::vector<VectorWithDistance> ShardedIndex::search(const Vector& query, size_t k,
+                                                     size_t efSearch) {
+    if (query.size() != dimension_) {
+        throw std::invalid_argument("Query dimension mismatch: expected " +
+                                    std::to_string(dimension_) + ", got " +
+                                    std::to_string(query.size()));
+    }
+
+    // scatter
+    std::vector<std::future<std::vector<VectorWithDistance>>> partials;
+    partials.reserve(shards_.size());
+    for (auto& shard : shards_) {
+        IndexShard* target = shard.get();
+        partials.push_back(pool_.submit([target, &query, k, efSearch]() {
+            return target->search(query, k, efSearch);
+        }));
+    }
+
+    // gather (every future is drained before an error propagates,
+    // since the tasks reference the caller's query)
+    std::vector<VectorWithDistance> merged;
+    for (auto& results : ThreadPool::waitAll(partials)) {
+        merged.insert(merged.end(), results.begin(), results.end());
+    }
+
+    // merge per-shard top-k lists into the global top-k
+    size_t resultCount = std::min(k, merged.size());
+    std::partial_sort(merged.begin(), merged.begin() + resultCount, merged.end());
+    merged.resize(resultCount);
+    return merged;
+}
+
+size_t ShardedIndex::size() {
+    size_t total = 0;
+    for (auto& shard : shards_) {
+        total += shard->size();
+    }
+    return total;
+}
+
+} // namespace atlas
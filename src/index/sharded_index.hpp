@@ -0,0 +1,141 @@
+#pragma once
+
+#include "../common/thread_pool.hpp"
+#include "../common/types.hpp"
+#include "../common/vector_store.hpp"
+#include "hnsw.hpp"
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * One partition of a ShardedIndex
+ *
+ * Implementations own their own vectors and graph; the sharded index
+ * only routes rows to them and merges their answers.
+ */
+class IndexShard {
+public:
+    virtual ~IndexShard() = default;
+
+    /**
+     * Store and index a batch of rows
+     * @param ids One ID per row
+     * @param data Row-major floats, ids.size() * dimension values
+     */
+    virtual void addVectors(std::span<const VectorId> ids, std::span<const float> data) = 0;
+
+    /**
+     * Top-k search within this shard
+     */
+    virtual std::vector<VectorWithDistance> search(const Vector& query, size_t k,
+                                                   size_t efSearch) = 0;
+
+    // Number of vectors held by this shard
+    virtual size_t size() = 0;
+};
+
+/**
+ * In-process shard: a VectorStore plus the HNSW graph over it
+ */
+class LocalShard : public IndexShard {
+public:
+    LocalShard(size_t dimension, size_t M = 16, size_t efConstruction = 200);
+
+    // All or nothing: a batch with a duplicate ID or a zero vector is rejected whole
+    void addVectors(std::span<const VectorId> ids, std::span<const float> data) override;
+    std::vector<VectorWithDistance> search(const Vector& query, size_t k,
+                                           size_t efSearch) override;
+    size_t size() override;
+
+private:
+    VectorStore store_;
+    HNSW index_;
+};
+
+/**
+ * How IDs are assigned to shards
+ *
+ * Hash:  mixed ID modulo shard count (even spread, no locality)
+ * Range: ID ranges split at ShardedIndexOptions::rangeSplits
+ */
+enum class PartitionScheme { Hash, Range };
+
+/**
+ * Options for ShardedIndex
+ */
+struct ShardedIndexOptions {
+    size_t numShards = 4;
+    PartitionScheme scheme = PartitionScheme::Hash;
+    std::vector<VectorId> rangeSplits;  // Range only: numShards - 1 ascending upper bounds
+    size_t M = 16;                      // HNSW parameters for local shards
+    size_t efConstruction = 200;
+    size_t numThreads = 0;              // Scatter-gather workers (0 = one per shard)
+};
+
+/**
+ * ShardedIndex - Partitioned index with parallel scatter-gather search
+ *
+ * IDs are partitioned across N shards, each with its own graph and entry
+ * point. Builds insert into all shards concurrently; a query is sent to
+ * every shard at once and the per-shard top-k lists are merged. Shards
+ * may be in-process (LocalShard) or remote stand-ins (RemoteShard).
+ */
+class ShardedIndex {
+public:
+    /**
+     * Constructor with in-process shards
+     * @param dimension Vector dimension
+     * @param options Shard count, partitioning and HNSW parameters
+     * @throws std::invalid_argument on inconsistent options
+     */
+    ShardedIndex(size_t dimension, const ShardedIndexOptions& options = {});
+
+    /**
+     * Constructor with caller-provided shards (e.g. remote ones)
+     * @param dimension Vector dimension
+     * @param shards One shard per partition
+     * @param options Partitioning (numShards/M/efConstruction are ignored)
+     */
+    ShardedIndex(size_t dimension, std::vector<std::unique_ptr<IndexShard>> shards,
+                 const ShardedIndexOptions& options = {});
+
+    /**
+     * Add one vector (routed to its shard)
+     */
+    void addVector(VectorId id, const Vector& vec);
+
+    /**
+     * Partition a batch and build all shards in parallel
+     * @param ids One ID per row
+     * @param data Row-major floats, ids.size() * dimension values
+     */
+    void build(std::span<const VectorId> ids, std::span<const float> data);
+
+    /**
+     * Scatter-gather top-k search over all shards
+     * @return Global top-k, sorted by distance ascending
+     */
+    std::vector<VectorWithDistance> search(const Vector& query, size_t k, size_t efSearch);
+
+    // Shard index that owns an ID
+    size_t shardFor(VectorId id) const;
+
+    // Number of shards
+    size_t numShards() const { return shards_.size(); }
+
+    // Total vectors across shards
+    size_t size();
+
+private:
+    void validateOptions() const;
+
+    size_t dimension_;
+    ShardedIndexOptions options_;
+    std::vector<std::unique_ptr<IndexShard>> shards_;
+    ThreadPool pool_;
+};
+
+} // namespace atlas
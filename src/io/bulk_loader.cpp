@@ -0,0 +1,339 @@
+#include "bulk_loader.hpp"
+#include "../distance/distance.hpp"
+#include "../index/hnsw.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <future>
+#include <numeric>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace atlas {
+
+namespace {
+
+/**
+ * Read-only memory mapping of a whole file (RAII)
+ */
+class MappedFile {
+public:
+  explicit MappedFile(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("Cannot open vector file: " + path);
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      throw std::runtime_error("Cannot stat vector file: " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+
+    if (size_ > 0) {
+      void *addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("Cannot map vector file: " + path);
+      }
+      data_ = static_cast<const uint8_t *>(addr);
+      // We read front to back exactly once
+      ::madvise(addr, size_, MADV_SEQUENTIAL);
+    }
+    ::close(fd);
+  }
+
+  ~MappedFile() {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<uint8_t *>(data_), size_);
+    }
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const uint8_t *data() const { return data_; }
+  size_t size() const { return size_; }
+
+private:
+  const uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+};
+
+/**
+ * Where the float rows live inside the mapped file
+ */
+struct FileLayout {
+  size_t count = 0;        // Number of vectors
+  size_t dimension = 0;    // Floats per vector
+  size_t dataOffset = 0;   // Byte offset of the first record
+  size_t recordStride = 0; // Bytes from one record to the next
+  size_t rowOffset = 0;    // Bytes from record start to its first float
+};
+
+uint32_t readLittleEndian32(const uint8_t *p) {
+  return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+         static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+FileLayout fvecsLayout(const MappedFile &file) {
+  FileLayout layout;
+  if (file.size() == 0) {
+    return layout;
+  }
+  if (file.size() < 4) {
+    throw std::runtime_error("Truncated .fvecs file");
+  }
+
+  layout.dimension = readLittleEndian32(file.data());
+  layout.rowOffset = sizeof(uint32_t);
+  layout.recordStride = sizeof(uint32_t) + layout.dimension * sizeof(float);
+  if (layout.dimension == 0 || file.size() % layout.recordStride != 0) {
+    throw std::runtime_error("Malformed .fvecs file: size " +
+                             std::to_string(file.size()) +
+                             " is not a multiple of the record size");
+  }
+  layout.count = file.size() / layout.recordStride;
+  return layout;
+}
+
+FileLayout npyLayout(const MappedFile &file) {
+  static const char magic[] = "\x93NUMPY";
+  const uint8_t *p = file.data();
+  if (file.size() < 10 || std::memcmp(p, magic, 6) != 0) {
+    throw std::runtime_error("Not a .npy file (bad magic)");
+  }
+
+  // Version 1.x has a 16-bit header length, 2.x/3.x a 32-bit one
+  uint8_t major = p[6];
+  size_t headerLen = 0;
+  size_t prefix = 0;
+  if (major == 1) {
+    headerLen = static_cast<size_t>(p[8]) | static_cast<size_t>(p[9]) << 8;
+    prefix = 10;
+  } else if (major == 2 || major == 3) {
+    if (file.size() < 12) {
+      throw std::runtime_error("Truncated .npy header");
+    }
+    headerLen = readLittleEndian32(p + 8);
+    prefix = 12;
+  } else {
+    throw std::runtime_error("Unsupported .npy version " +
+                             std::to_string(major));
+  }
+  if (prefix + headerLen > file.size()) {
+    throw std::runtime_error("Truncated .npy header");
+  }
+
+  std::string header(reinterpret_cast<const char *>(p + prefix), headerLen);
+  if (header.find("'descr': '<f4'") == std::string::npos) {
+    throw std::runtime_error(".npy array must be little-endian float32");
+  }
+  if (header.find("'fortran_order': False") == std::string::npos) {
+    throw std::runtime_error(".npy array must be in C order");
+  }
+
+  // 'shape': (n, d)
+  size_t shapePos = header.find("'shape':");
+  size_t open = header.find('(', shapePos);
+  size_t close = header.find(')', open);
+  if (shapePos == std::string::npos || open == std::string::npos ||
+      close == std::string::npos) {
+    throw std::runtime_error("Malformed .npy shape");
+  }
+  std::string shape = header.substr(open + 1, close - open - 1);
+
+  // exactly two non-empty integer fields (a 1-D shape is "(n,)")
+  std::vector<size_t> dims;
+  size_t start = 0;
+  while (true) {
+    size_t comma = shape.find(',', start);
+    std::string field = shape.substr(
+        start, comma == std::string::npos ? std::string::npos : comma - start);
+    size_t first = field.find_first_not_of(' ');
+    size_t last = field.find_last_not_of(' ');
+    if (first == std::string::npos) {
+      throw std::runtime_error(".npy array must be 2-dimensional");
+    }
+    field = field.substr(first, last - first + 1);
+    if (field.find_first_not_of("0123456789") != std::string::npos ||
+        field.size() > 18) {
+      throw std::runtime_error("Malformed .npy shape");
+    }
+    dims.push_back(std::stoull(field));
+    if (comma == std::string::npos) {
+      break;
+    }
+    start = comma + 1;
+  }
+  if (dims.size() != 2) {
+    throw std::runtime_error(".npy array must be 2-dimensional");
+  }
+
+  FileLayout layout;
+  layout.count = dims[0];
+  layout.dimension = dims[1];
+  layout.dataOffset = prefix + headerLen;
+  layout.recordStride = layout.dimension * sizeof(float);
+  size_t dataBytes = file.size() - layout.dataOffset;
+  bool sizeMatches = layout.recordStride == 0
+                         ? dataBytes == 0
+                         : dataBytes % layout.recordStride == 0 &&
+                               dataBytes / layout.recordStride == layout.count;
+  if (!sizeMatches) {
+    throw std::runtime_error(".npy data size does not match its shape");
+  }
+  return layout;
+}
+
+FileLayout rawLayout(const MappedFile &file, size_t dimension) {
+  FileLayout layout;
+  layout.dimension = dimension;
+  layout.recordStride = dimension * sizeof(float);
+  if (file.size() % layout.recordStride != 0) {
+    throw std::runtime_error("Raw float32 file size " +
+                             std::to_string(file.size()) +
+                             " is not a multiple of the vector size");
+  }
+  layout.count = file.size() / layout.recordStride;
+  return layout;
+}
+
+/**
+ * Copy records [begin, end) into one flat row-major buffer
+ * (runs on a worker thread)
+ */
+std::vector<float> parseChunk(const MappedFile &file, const FileLayout &layout,
+                              VectorFileFormat format, bool normalizeRows,
+                              size_t begin, size_t end) {
+  std::vector<float> rows((end - begin) * layout.dimension);
+  const size_t rowBytes = layout.dimension * sizeof(float);
+
+  for (size_t i = begin; i < end; i++) {
+    const uint8_t *record =
+        file.data() + layout.dataOffset + i * layout.recordStride;
+    if (format == VectorFileFormat::Fvecs &&
+        readLittleEndian32(record) != layout.dimension) {
+      throw std::runtime_error("Inconsistent dimension in .fvecs record " +
+                               std::to_string(i));
+    }
+
+    float *row = rows.data() + (i - begin) * layout.dimension;
+    std::memcpy(row, record + layout.rowOffset, rowBytes);
+    if (normalizeRows) {
+      normalize(std::span<float>(row, layout.dimension));
+    }
+  }
+  return rows;
+}
+
+} // namespace
+
+VectorFileFormat detectFormat(const std::string &path) {
+  auto endsWith = [&path](const std::string &suffix) {
+    return path.size() >= suffix.size() &&
+           path.compare(path.size() - suffix.size(), suffix.size(), suffix) ==
+               0;
+  };
+  if (endsWith(".fvecs")) {
+    return VectorFileFormat::Fvecs;
+  }
+  if (endsWith(".npy")) {
+    return VectorFileFormat::Npy;
+  }
+  return VectorFileFormat::RawFloat32;
+}
+
+BulkLoadStats bulkLoad(const std::string &path, VectorFileFormat format,
+                       VectorStore &store, const BulkLoadOptions &options,
+                       HNSW *index) {
+  auto start = std::chrono::steady_clock::now();
+
+  MappedFile file(path);
+  FileLayout layout;
+  switch (format) {
+  case VectorFileFormat::Fvecs:
+    layout = fvecsLayout(file);
+    break;
+  case VectorFileFormat::Npy:
+    layout = npyLayout(file);
+    break;
+  case VectorFileFormat::RawFloat32:
+    layout = rawLayout(file, store.getDimension());
+    break;
+  }
+
+  BulkLoadStats stats;
+  stats.bytesRead = file.size();
+  if (layout.count == 0) {
+    return stats;
+  }
+
+  // Validate dimension
+  if (layout.dimension != store.getDimension()) {
+    throw std::invalid_argument("Vector dimension mismatch: expected " +
+                                std::to_string(store.getDimension()) +
+                                ", got " + std::to_string(layout.dimension));
+  }
+
+  store.reserve(store.size() + layout.count);
+
+  const size_t chunkSize = std::max<size_t>(options.chunkSize, 1);
+  const size_t window = std::max<size_t>(options.numThreads, 1);
+  std::deque<std::future<std::vector<float>>> inFlight;
+  std::vector<VectorId> ids;
+  size_t nextChunk = 0;
+
+  auto launch = [&]() {
+    size_t begin = nextChunk;
+    size_t end = std::min(begin + chunkSize, layout.count);
+    nextChunk = end;
+    inFlight.push_back(std::async(std::launch::async, parseChunk,
+                                  std::cref(file), std::cref(layout), format,
+                                  options.normalize, begin, end));
+  };
+
+  // Keep up to `window` chunks parsing ahead of the consumer
+  while (nextChunk < layout.count && inFlight.size() < window) {
+    launch();
+  }
+
+  size_t loaded = 0;
+  while (!inFlight.empty()) {
+    std::vector<float> rows = inFlight.front().get();
+    inFlight.pop_front();
+    if (nextChunk < layout.count) {
+      launch();
+    }
+
+    size_t rowsInChunk = rows.size() / layout.dimension;
+    ids.resize(rowsInChunk);
+    std::iota(ids.begin(), ids.end(), options.firstId + loaded);
+    store.addVectors(ids, rows);
+
+    if (index != nullptr) {
+      for (VectorId id : ids) {
+        index->addVector(id);
+      }
+    }
+    loaded += rowsInChunk;
+  }
+
+  stats.vectorsLoaded = loaded;
+  stats.seconds = std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+  return stats;
+}
+
+BulkLoadStats bulkLoad(const std::string &path, VectorStore &store,
+                       const BulkLoadOptions &options, HNSW *index) {
+  return bulkLoad(path, detectFormat(path), store, options, index);
+}
+
+} // namespace atlas
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../common/types.hpp"
+#include "../common/vector_store.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <thread>
+
+namespace atlas {
+
+class HNSW;
+
+/**
+ * On-disk vector formats understood by the bulk loader
+ *
+ * Fvecs:      per record an int32 dimension followed by that many float32
+ * Npy:        NumPy .npy, little-endian float32 ('<f4'), C order, shape (n, d)
+ * RawFloat32: headerless row-major float32, dimension taken from the store
+ */
+enum class VectorFileFormat { Fvecs, Npy, RawFloat32 };
+
+/**
+ * Options for bulkLoad()
+ */
+struct BulkLoadOptions {
+  VectorId firstId = 0;   // Record i is stored under firstId + i
+  size_t chunkSize = 4096; // Vectors parsed per worker task
+  size_t numThreads =      // Parse/normalize workers (chunks in flight)
+      std::max(1u, std::thread::hardware_concurrency());
+  bool normalize = false; // L2-normalize every vector before storing
+};
+
+/**
+ * Summary of a finished bulk load
+ */
+struct BulkLoadStats {
+  size_t vectorsLoaded = 0; // Vectors appended to the store
+  size_t bytesRead = 0;     // Size of the input file
+  double seconds = 0.0;     // Wall-clock time for the whole load
+};
+
+/**
+ * Pick the file format from the path's extension
+ * (.fvecs, .npy, anything else is treated as raw float32)
+ */
+VectorFileFormat detectFormat(const std::string &path);
+
+/**
+ * Load every vector of a file into a store (and optionally an index)
+ *
+ * The file is memory-mapped and cut into chunks. Worker threads copy and
+ * (optionally) normalize chunks into flat buffers while the calling thread
+ * appends finished chunks, in file order, to the store's arena with one
+ * VectorStore::addVectors call per chunk and feeds them to the index.
+ *
+ * @param path Input file
+ * @param format Layout of the file
+ * @param store Destination store (dimension must match the file)
+ * @param options IDs, chunking, threading and normalization
+ * @param index Optional HNSW built over the store, updated as chunks land
+ * @return Counts and timing for the load
+ * @throws std::runtime_error if the file cannot be read or is malformed
+ *         (chunks appended before the error stay in the store)
+ * @throws std::invalid_argument if the file dimension mismatches the store
+ */
+BulkLoadStats bulkLoad(const std::string &path, VectorFileFormat format,
+                       VectorStore &store, const BulkLoadOptions &options = {},
+                       HNSW *index = nullptr);
+
+/**
+ * Same as above, with the format detected from the extension
+ */
+BulkLoadStats bulkLoad(const std::string &path, VectorStore &store,
+                       const BulkLoadOptions &options = {},
+                       HNSW *index = nullptr);
+
+} // namespace atlas
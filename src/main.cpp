@@ -1,47 +1,104 @@
+#include "common/vector_store.hpp"
+#include "index/hnsw.hpp"
+#include "net/vector_server.hpp"
+#include <csignal>
+#include <cstdlib>
 #include <iostream>
 #include <string>
-#include <vector>
-#include <thread>
-#include <chrono>
 
 /**
- * Placeholder Vector Search Engine
- * This is a minimal stub to test your Docker setup
- * You'll replace this with the actual HNSW implementation later
+ * Atlas Vector Search Engine server
+ *
+ * Serves an in-memory HNSW index over the binary wire protocol
+ * (src/net/wire_protocol.hpp) on a TCP port and/or a Unix domain socket.
+ * Vectors are added by clients with Insert frames.
+ *
+ * Usage: vector-search-engine [--dim N] [--port N] [--host ADDR]
+ *                             [--unix PATH] [--M N] [--ef-construction N]
  */
 
+namespace {
+
+atlas::VectorServer* gServer = nullptr;
+
+void handleSignal(int) {
+    if (gServer) {
+        gServer->stop();
+    }
+}
+
+void usage(const char* program) {
+    std::cerr << "Usage: " << program
+              << " [--dim N] [--port N] [--host ADDR] [--unix PATH]"
+                 " [--M N] [--ef-construction N]" << std::endl;
+}
+
+} // namespace
+
 int main(int argc, char* argv[]) {
-    std::cout << "========================================" << std::endl;
-    std::cout << "  Atlas Vector Search Engine v1.0" << std::endl;
-    std::cout << "========================================" << std::endl;
-    std::cout << std::endl;
-    
-    std::cout << "✓ Docker container is working!" << std::endl;
-    std::cout << "✓ C++ compilation successful" << std::endl;
-    std::cout << "✓ Ready to implement HNSW algorithm" << std::endl;
-    std::cout << std::endl;
-    
-    std::cout << "Next steps:" << std::endl;
-    std::cout << "1. Implement vector store (src/common/vector_store.cpp)" << std::endl;
-    std::cout << "2. Implement HNSW index (src/index/hnsw.cpp)" << std::endl;
-    std::cout << "3. Add HTTP server (src/server/http_server.cpp)" << std::endl;
-    std::cout << "4. Add SIMD optimizations (src/simd/dot_avx2.cpp)" << std::endl;
-    std::cout << std::endl;
-    
-    std::cout << "Server would be listening on port 8080..." << std::endl;
-    std::cout << "(Press Ctrl+C to stop)" << std::endl;
-    
-    // Keep the container running for testing
-    // In the real implementation, this would be your HTTP server loop
-    std::cout << std::endl;
-    std::cout << "Placeholder server running. Waiting indefinitely..." << std::endl;
-    
-    // Simulate a server running
-    while(true) {
-        // Sleep to prevent CPU spinning
-        // In real code, this would be your event loop
-        std::this_thread::sleep_for(std::chrono::seconds(10));
+    size_t dim = 768;
+    long port = 8080;  // -1 = no TCP listener
+    std::string host = "0.0.0.0";
+    std::string unixPath;
+    size_t M = 16;
+    size_t efConstruction = 200;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--dim") {
+            dim = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--port") {
+            port = std::strtol(value.c_str(), nullptr, 10);
+        } else if (arg == "--host") {
+            host = value;
+        } else if (arg == "--unix") {
+            unixPath = value;
+        } else if (arg == "--M") {
+            M = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--ef-construction") {
+            efConstruction = std::strtoull(value.c_str(), nullptr, 10);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    try {
+        atlas::VectorStore store(dim);
+        atlas::HNSW index(store, M, efConstruction);
+        atlas::VectorServer server(store, index);
+
+        std::cout << "========================================" << std::endl;
+        std::cout << "  Atlas Vector Search Engine v1.0" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "Dimension: " << dim << ", M: " << M
+                  << ", efConstruction: " << efConstruction << std::endl;
+        if (port >= 0) {
+            uint16_t bound = server.listenTcp(static_cast<uint16_t>(port), host);
+            std::cout << "Listening on " << host << ":" << bound << std::endl;
+        }
+        if (!unixPath.empty()) {
+            server.listenUnix(unixPath);
+            std::cout << "Listening on " << unixPath << std::endl;
+        }
+
+        gServer = &server;
+        std::signal(SIGINT, handleSignal);
+        std::signal(SIGTERM, handleSignal);
+
+        server.run();
+
+        gServer = nullptr;
+        std::cout << "Shutting down (" << store.size() << " vectors)" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal: " << e.what() << std::endl;
+        return 1;
     }
-    
+
     return 0;
 }
@@ -0,0 +1,163 @@
+#include "recall_sampler.hpp"
+#include <pthread.h>
+#include <random>
+#include <sched.h>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace atlas {
+
+RecallSampler::RecallSampler(const VectorStore& store, const RecallSamplerOptions& options)
+    : RecallSampler(store, ownStoreMutex_, options) {}
+
+RecallSampler::RecallSampler(const VectorStore& store, std::shared_mutex& storeMutex,
+                             const RecallSamplerOptions& options)
+    : store_(store), storeMutex_(storeMutex), options_(options) {
+    if (options_.sampleRate < 0.0 || options_.sampleRate > 1.0) {
+        throw std::invalid_argument("Sample rate must be in [0, 1]");
+    }
+    if (!(options_.maxCpuFraction > 0.0) || options_.maxCpuFraction > 1.0) {
+        throw std::invalid_argument("CPU fraction must be in (0, 1]");
+    }
+    if (options_.queueCapacity == 0 || options_.window == 0) {
+        throw std::invalid_argument("Queue capacity and window must be greater than 0");
+    }
+    worker_ = std::thread(&RecallSampler::run, this);
+}
+
+RecallSampler::~RecallSampler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    worker_.join();
+}
+
+void RecallSampler::observe(const Vector& query, const std::vector<VectorWithDistance>& served,
+                            size_t k, std::chrono::microseconds latency) {
+    observed_.fetch_add(1, std::memory_order_relaxed);
+
+    // sampling decision without touching shared state
+    thread_local std::minstd_rand rng(std::random_device{}());
+    thread_local std::uniform_real_distribution<double> coin(0.0, 1.0);
+    if (options_.sampleRate <= 0.0 || coin(rng) >= options_.sampleRate) {
+        return;
+    }
+
+    Sample sample{query, {}, k, latency.count() / 1000.0};
+    sample.served.reserve(served.size());
+    for (const auto& result : served) {
+        sample.served.push_back(result.id);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.size() >= options_.queueCapacity) {
+            counters_.dropped++;
+            return;
+        }
+        queue_.push_back(std::move(sample));
+    }
+    wake_.notify_one();
+}
+
+RecallMetrics RecallSampler::metrics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    RecallMetrics out = counters_;
+    out.observed = observed_.load(std::memory_order_relaxed);
+    if (!recallWindow_.empty()) {
+        out.rollingRecall = recallSum_ / recallWindow_.size();
+        out.rollingLatencyMs = latencySum_ / latencyWindow_.size();
+    }
+    return out;
+}
+
+void RecallSampler::drain() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this]() { return queue_.empty() && !busy_; });
+}
+
+double RecallSampler::recallAt(const std::vector<VectorId>& served,
+                               const std::vector<VectorWithDistance>& exact) {
+    if (exact.empty()) {
+        return 1.0;
+    }
+    std::unordered_set<VectorId> truth;
+    for (const auto& result : exact) {
+        truth.insert(result.id);
+    }
+    size_t hits = 0;
+    for (VectorId id : served) {
+        hits += truth.count(id);
+    }
+    return static_cast<double>(hits) / exact.size();
+}
+
+void RecallSampler::pushWindow(std::deque<double>& window, double& sum, double value) {
+    window.push_back(value);
+    sum += value;
+    if (window.size() > options_.window) {
+        sum -= window.front();
+        window.pop_front();
+    }
+}
+
+void RecallSampler::run() {
+    // shadow work only gets otherwise idle CPU time
+    sched_param param{};
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+
+    while (true) {
+        Sample sample;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            idle_.notify_all();
+            wake_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            sample = std::move(queue_.front());
+            queue_.pop_front();
+            busy_ = true;
+        }
+
+        std::chrono::duration<double> spent{0.0};
+        double recall = 1.0;
+        {
+            // time spent waiting for writers is not shadow CPU
+            std::shared_lock<std::shared_mutex> storeLock(storeMutex_);
+            auto start = std::chrono::steady_clock::now();
+            try {
+                recall = recallAt(sample.served, store_.bruteForceSearch(sample.query, sample.k));
+            } catch (const std::exception&) {
+                recall = -1.0;  // malformed query: skip it
+            }
+            spent = std::chrono::steady_clock::now() - start;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            busy_ = false;
+            counters_.shadowCpuSeconds += spent.count();
+            if (recall >= 0.0) {
+                counters_.sampled++;
+                pushWindow(recallWindow_, recallSum_, recall);
+                pushWindow(latencyWindow_, latencySum_, sample.latencyMs);
+            }
+        }
+
+        // duty cycle: work `spent`, then rest so work / (work + rest) <= maxCpuFraction
+        auto rest = spent * (1.0 / options_.maxCpuFraction - 1.0);
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (queue_.empty()) {
+            idle_.notify_all();
+        }
+        wake_.wait_for(lock, rest, [this]() { return stopping_; });
+        if (stopping_) {
+            return;
+        }
+    }
+}
+
+} // namespace atlas
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "../common/types.hpp"
+#include "../common/vector_store.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * Configuration for RecallSampler
+ */
+struct RecallSamplerOptions {
+    double sampleRate = 0.01;      // Fraction of observed queries shadowed
+    double maxCpuFraction = 0.05;  // Hard cap on shadow CPU (fraction of one core)
+    size_t queueCapacity = 64;     // Pending samples; extra samples are dropped
+    size_t window = 1000;          // Samples in the rolling averages
+};
+
+/**
+ * Published online-quality metrics
+ */
+struct RecallMetrics {
+    double rollingRecall = 0.0;    // Mean recall@k over the window
+    double rollingLatencyMs = 0.0; // Mean served latency of the sampled queries in the window
+    uint64_t observed = 0;         // Queries passed to observe()
+    uint64_t sampled = 0;          // Shadow queries completed
+    uint64_t dropped = 0;          // Samples dropped (queue full)
+    double shadowCpuSeconds = 0.0; // Time spent in brute-force shadow queries
+};
+
+/**
+ * RecallSampler - Online recall estimation by shadow brute-force queries
+ *
+ * Serving threads call observe() with each answered query. A fraction is
+ * copied onto a bounded queue (never blocking the caller); a single
+ * low-priority background thread re-runs those queries through exact
+ * VectorStore::bruteForceSearch and records recall@k of the served
+ * answer in a rolling window. After every shadow query the thread sleeps
+ * long enough to keep its duty cycle under maxCpuFraction.
+ *
+ * Shadow queries hold storeMutex shared; code that adds vectors to the
+ * store while the sampler runs must hold it exclusively (addVector may
+ * reallocate the store's arena under a running brute-force scan). The
+ * constructor without a mutex is for stores that are not modified.
+ */
+class RecallSampler {
+public:
+    RecallSampler(const VectorStore& store, const RecallSamplerOptions& options = {});
+
+    /**
+     * @param store Store queried by the shadow brute-force searches
+     * @param storeMutex Held shared by shadow queries, exclusively by writers
+     * @param options Sampling configuration
+     * @throws std::invalid_argument if an option is out of range
+     */
+    RecallSampler(const VectorStore& store, std::shared_mutex& storeMutex,
+                  const RecallSamplerOptions& options = {});
+    ~RecallSampler();
+
+    RecallSampler(const RecallSampler&) = delete;
+    RecallSampler& operator=(const RecallSampler&) = delete;
+
+    /**
+     * Report a served query (cheap unless the query is sampled)
+     * @param query Query vector
+     * @param served Results returned to the client
+     * @param k Number of results requested
+     * @param latency Serving latency of the query
+     */
+    void observe(const Vector& query, const std::vector<VectorWithDistance>& served,
+                 size_t k, std::chrono::microseconds latency = std::chrono::microseconds(0));
+
+    // Snapshot of the current metrics
+    RecallMetrics metrics() const;
+
+    // Block until every queued sample has been processed (for tests/shutdown)
+    void drain();
+
+private:
+    struct Sample {
+        Vector query;
+        std::vector<VectorId> served;
+        size_t k;
+        double latencyMs;
+    };
+
+    void run();
+    static double recallAt(const std::vector<VectorId>& served,
+                           const std::vector<VectorWithDistance>& exact);
+    void pushWindow(std::deque<double>& window, double& sum, double value);
+
+    const VectorStore& store_;
+    std::shared_mutex ownStoreMutex_;  // Used when no mutex is shared with writers
+    std::shared_mutex& storeMutex_;
+    RecallSamplerOptions options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::deque<Sample> queue_;
+    bool busy_ = false;
+    bool stopping_ = false;
+    std::atomic<uint64_t> observed_{0};
+
+    std::deque<double> recallWindow_;
+    double recallSum_ = 0.0;
+    std::deque<double> latencyWindow_;
+    double latencySum_ = 0.0;
+    RecallMetrics counters_;
+
+    std::thread worker_;
+};
+
+} // namespace atlas
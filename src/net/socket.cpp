@@ -0,0 +1,177 @@
+#include "socket.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace atlas {
+
+namespace {
+
+sockaddr_un unixAddress(const std::string& path) {
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw std::invalid_argument("Unix socket path too long: " + path);
+    }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return addr;
+}
+
+sockaddr_in inetAddress(const std::string& host, uint16_t port) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (::inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1) {
+        throw std::invalid_argument("Invalid IPv4 address: " + host);
+    }
+    return addr;
+}
+
+std::runtime_error socketError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+} // namespace
+
+FileDescriptor::~FileDescriptor() { reset(); }
+
+FileDescriptor::FileDescriptor(FileDescriptor&& other) noexcept : fd_(other.fd_) {
+    other.fd_ = -1;
+}
+
+FileDescriptor& FileDescriptor::operator=(FileDescriptor&& other) noexcept {
+    if (this != &other) {
+        reset();
+        fd_ = other.fd_;
+        other.fd_ = -1;
+    }
+    return *this;
+}
+
+void FileDescriptor::reset() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+void writeAll(int fd, const void* data, size_t len) {
+    const char* p = static_cast<const char*>(data);
+    while (len > 0) {
+        ssize_t n = ::send(fd, p, len, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw socketError("Socket write failed");
+        }
+        p += n;
+        len -= static_cast<size_t>(n);
+    }
+}
+
+void readAll(int fd, void* data, size_t len) {
+    char* p = static_cast<char*>(data);
+    while (len > 0) {
+        ssize_t n = ::read(fd, p, len);
+        if (n == 0) {
+            throw std::runtime_error("Socket closed by peer");
+        }
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw socketError("Socket read failed");
+        }
+        p += n;
+        len -= static_cast<size_t>(n);
+    }
+}
+
+FileDescriptor listenUnix(const std::string& path, int backlog) {
+    sockaddr_un addr = unixAddress(path);
+    FileDescriptor fd(::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    if (!fd.valid()) {
+        throw socketError("Cannot create Unix socket");
+    }
+
+    ::unlink(path.c_str());
+    if (::bind(fd.get(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        throw socketError("Cannot bind " + path);
+    }
+    if (::listen(fd.get(), backlog) != 0) {
+        throw socketError("Cannot listen on " + path);
+    }
+    return fd;
+}
+
+FileDescriptor connectUnix(const std::string& path) {
+    sockaddr_un addr = unixAddress(path);
+    FileDescriptor fd(::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    if (!fd.valid()) {
+        throw socketError("Cannot create Unix socket");
+    }
+    if (::connect(fd.get(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        throw socketError("Cannot connect to " + path);
+    }
+    return fd;
+}
+
+FileDescriptor listenTcp(const std::string& host, uint16_t port, int backlog) {
+    sockaddr_in addr = inetAddress(host, port);
+    FileDescriptor fd(::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    if (!fd.valid()) {
+        throw socketError("Cannot create TCP socket");
+    }
+
+    int on = 1;
+    ::setsockopt(fd.get(), SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    if (::bind(fd.get(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        throw socketError("Cannot bind " + host + ":" + std::to_string(port));
+    }
+    if (::listen(fd.get(), backlog) != 0) {
+        throw socketError("Cannot listen on " + host + ":" + std::to_string(port));
+    }
+    return fd;
+}
+
+FileDescriptor connectTcp(const std::string& host, uint16_t port) {
+    sockaddr_in addr = inetAddress(host, port);
+    FileDescriptor fd(::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    if (!fd.valid()) {
+        throw socketError("Cannot create TCP socket");
+    }
+    if (::connect(fd.get(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        throw socketError("Cannot connect to " + host + ":" + std::to_string(port));
+    }
+
+    // small request/response frames: send them immediately
+    int on = 1;
+    ::setsockopt(fd.get(), IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    return fd;
+}
+
+uint16_t localPort(int fd) {
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+        throw socketError("Cannot read socket address");
+    }
+    return ntohs(addr.sin_port);
+}
+
+void setNonBlocking(int fd) {
+    int flags = ::fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) {
+        throw socketError("Cannot make socket non-blocking");
+    }
+}
+
+} // namespace atlas
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace atlas {
+
+/**
+ * Owning wrapper around a POSIX file descriptor (closes on destruction)
+ */
+class FileDescriptor {
+public:
+    FileDescriptor() = default;
+    explicit FileDescriptor(int fd) : fd_(fd) {}
+    ~FileDescriptor();
+
+    FileDescriptor(FileDescriptor&& other) noexcept;
+    FileDescriptor& operator=(FileDescriptor&& other) noexcept;
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    int get() const { return fd_; }
+    bool valid() const { return fd_ >= 0; }
+
+    // Close now (idempotent)
+    void reset();
+
+private:
+    int fd_ = -1;
+};
+
+/**
+ * Write exactly len bytes (retries on short writes / EINTR)
+ * @throws std::runtime_error if the peer is gone or the write fails
+ */
+void writeAll(int fd, const void* data, size_t len);
+
+/**
+ * Read exactly len bytes (retries on short reads / EINTR)
+ * @throws std::runtime_error on EOF or read failure
+ */
+void readAll(int fd, void* data, size_t len);
+
+/**
+ * Create a listening Unix domain socket (removes a stale socket file)
+ * @throws std::runtime_error on failure
+ */
+FileDescriptor listenUnix(const std::string& path, int backlog = 64);
+
+/**
+ * Connect to a Unix domain socket
+ * @throws std::runtime_error on failure
+ */
+FileDescriptor connectUnix(const std::string& path);
+
+/**
+ * Create a listening TCP socket (IPv4, SO_REUSEADDR)
+ * @param host Dotted-quad address to bind ("0.0.0.0" = all interfaces)
+ * @param port Port to bind (0 = any free port, see localPort)
+ * @throws std::runtime_error on failure
+ */
+FileDescriptor listenTcp(const std::string& host, uint16_t port, int backlog = 64);
+
+/**
+ * Connect to a TCP server (IPv4, Nagle disabled)
+ * @throws std::runtime_error on failure
+ */
+FileDescriptor connectTcp(const std::string& host, uint16_t port);
+
+/**
+ * Port a TCP socket is bound to
+ * @throws std::runtime_error on failure
+ */
+uint16_t localPort(int fd);
+
+/**
+ * Switch a descriptor to non-blocking mode
+ * @throws std::runtime_error on failure
+ */
+void setNonBlocking(int fd);
+
+} // namespace atlas
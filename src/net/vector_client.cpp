@@ -0,0 +1,116 @@
+#include "vector_client.hpp"
+#include <stdexcept>
+
+namespace atlas {
+
+VectorClient VectorClient::connectUnix(const std::string& path) {
+    return VectorClient(atlas::connectUnix(path));
+}
+
+VectorClient VectorClient::connectTcp(const std::string& host, uint16_t port) {
+    return VectorClient(atlas::connectTcp(host, port));
+}
+
+VectorClient::VectorClient(FileDescriptor conn) : conn_(std::move(conn)) {}
+
+std::vector<VectorWithDistance> VectorClient::search(const Vector& query, size_t k,
+                                                     size_t efSearch) {
+    auto results = searchBatch(query, query.size(), k, efSearch);
+    return std::move(results.at(0));
+}
+
+std::vector<std::vector<VectorWithDistance>> VectorClient::searchBatch(
+    std::span<const float> queries, size_t dim, size_t k, size_t efSearch) {
+    return receiveSearch(sendSearch(queries, dim, k, efSearch));
+}
+
+void VectorClient::insert(std::span<const VectorId> ids, std::span<const float> data) {
+    receiveInsert(sendInsert(ids, data));
+}
+
+uint64_t VectorClient::size() {
+    uint32_t requestId = nextRequestId_++;
+    wire::FrameWriter writer(out_, wire::Op::Size, requestId);
+    writer.finish();
+    send();
+    return receive(requestId, wire::Op::Size).get<uint64_t>();
+}
+
+uint32_t VectorClient::sendSearch(std::span<const float> queries, size_t dim, size_t k,
+                                  size_t efSearch) {
+    if (dim == 0 || queries.size() % dim != 0) {
+        throw std::invalid_argument("Query data is not a whole number of rows of dimension " +
+                                    std::to_string(dim));
+    }
+    uint32_t requestId = nextRequestId_++;
+    wire::FrameWriter writer(out_, wire::Op::Search, requestId);
+    writer.put<uint32_t>(static_cast<uint32_t>(k));
+    writer.put<uint32_t>(static_cast<uint32_t>(efSearch));
+    writer.put<uint32_t>(static_cast<uint32_t>(dim));
+    writer.put<uint32_t>(static_cast<uint32_t>(queries.size() / dim));
+    writer.putArray(queries);
+    writer.finish();
+    send();
+    return requestId;
+}
+
+uint32_t VectorClient::sendInsert(std::span<const VectorId> ids, std::span<const float> data) {
+    if (ids.empty() || data.size() % ids.size() != 0) {
+        throw std::invalid_argument("Insert data is not a whole number of rows");
+    }
+    uint32_t requestId = nextRequestId_++;
+    wire::FrameWriter writer(out_, wire::Op::Insert, requestId);
+    writer.put<uint32_t>(static_cast<uint32_t>(data.size() / ids.size()));
+    writer.put<uint32_t>(static_cast<uint32_t>(ids.size()));
+    writer.putArray(ids);
+    writer.putArray(data);
+    writer.finish();
+    send();
+    return requestId;
+}
+
+std::vector<std::vector<VectorWithDistance>> VectorClient::receiveSearch(uint32_t requestId) {
+    wire::FrameReader reader = receive(requestId, wire::Op::Search);
+    std::vector<std::vector<VectorWithDistance>> results;
+    while (reader.remaining() > 0) {
+        auto& list = results.emplace_back(reader.get<uint32_t>());
+        for (auto& result : list) {
+            result.id = reader.get<uint64_t>();
+            result.distance = reader.get<float>();
+        }
+    }
+    return results;
+}
+
+void VectorClient::receiveInsert(uint32_t requestId) {
+    receive(requestId, wire::Op::Insert);
+}
+
+void VectorClient::send() {
+    writeAll(conn_.get(), out_.data(), out_.size());
+    out_.clear();
+}
+
+wire::FrameReader VectorClient::receive(uint32_t requestId, wire::Op op) {
+    char headerBytes[wire::kHeaderSize];
+    readAll(conn_.get(), headerBytes, wire::kHeaderSize);
+    wire::FrameHeader header = wire::decodeHeader(headerBytes);
+    if (header.length > wire::kMaxFrameLength) {
+        throw std::runtime_error("Server sent an oversized frame");
+    }
+    in_.resize(header.length);
+    readAll(conn_.get(), in_.data(), in_.size());
+
+    if (header.requestId != requestId || header.op != op) {
+        throw std::runtime_error("Out-of-order response: expected request " +
+                                 std::to_string(requestId) + ", got " +
+                                 std::to_string(header.requestId));
+    }
+    wire::FrameReader reader(in_);
+    if (header.status != wire::Status::Ok) {
+        throw std::runtime_error("Server error: " + reader.rest());
+    }
+    return reader;
+}
+
+} // namespace atlas
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "../common/types.hpp"
+#include "socket.hpp"
+#include "wire_protocol.hpp"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * VectorClient - Blocking client for VectorServer's binary wire protocol
+ *
+ * The simple calls (search, searchBatch, insert, size) send one frame and
+ * wait for its answer. For pipelining, send several requests with the
+ * send* calls and collect the answers with the matching receive* calls in
+ * the same order: the server answers each connection in request order.
+ * Not thread-safe; use one client per thread.
+ */
+class VectorClient {
+public:
+    /**
+     * Connect over a Unix domain socket
+     * @throws std::runtime_error if the connection fails
+     */
+    static VectorClient connectUnix(const std::string& path);
+
+    /**
+     * Connect over TCP
+     * @throws std::runtime_error if the connection fails
+     */
+    static VectorClient connectTcp(const std::string& host, uint16_t port);
+
+    explicit VectorClient(FileDescriptor conn);
+
+    /**
+     * Search one query
+     * @throws std::runtime_error on I/O failure or a server-side error
+     */
+    std::vector<VectorWithDistance> search(const Vector& query, size_t k, size_t efSearch = 64);
+
+    /**
+     * Search several queries in one frame
+     * @param queries numQueries * dim floats, one query per row
+     * @param dim Query dimension
+     * @return One result list per query, in order
+     * @throws std::invalid_argument if queries is not a multiple of dim
+     * @throws std::runtime_error on I/O failure or a server-side error
+     */
+    std::vector<std::vector<VectorWithDistance>> searchBatch(std::span<const float> queries,
+                                                             size_t dim, size_t k,
+                                                             size_t efSearch = 64);
+
+    /**
+     * Insert a batch of vectors (added to the store and the index)
+     * @param ids IDs of the rows
+     * @param data ids.size() * dim floats, one row per ID
+     * @throws std::invalid_argument if data is not a whole number of rows
+     * @throws std::runtime_error on I/O failure or a server-side error
+     *         (e.g. duplicate ID: then nothing from the batch is stored)
+     */
+    void insert(std::span<const VectorId> ids, std::span<const float> data);
+
+    /**
+     * Number of vectors on the server
+     * @throws std::runtime_error on I/O failure
+     */
+    uint64_t size();
+
+    // Pipelining: send now, receive later (in send order); each returns the request ID
+    uint32_t sendSearch(std::span<const float> queries, size_t dim, size_t k, size_t efSearch = 64);
+    uint32_t sendInsert(std::span<const VectorId> ids, std::span<const float> data);
+    std::vector<std::vector<VectorWithDistance>> receiveSearch(uint32_t requestId);
+    void receiveInsert(uint32_t requestId);
+
+private:
+    // Write the buffered frame(s)
+    void send();
+
+    // Read the next response into in_; it must answer requestId with op
+    wire::FrameReader receive(uint32_t requestId, wire::Op op);
+
+    FileDescriptor conn_;
+    uint32_t nextRequestId_ = 1;
+    std::vector<char> out_;
+    std::vector<char> in_;
+};
+
+} // namespace atlas
@@ -0,0 +1,357 @@
+#include "vector_server.hpp"
+#include "../distance/distance.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace atlas {
+
+namespace {
+
+std::runtime_error eventLoopError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+void epollControl(int epollFd, int op, int fd, uint32_t events) {
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    if (::epoll_ctl(epollFd, op, fd, &event) != 0) {
+        throw eventLoopError("epoll_ctl failed");
+    }
+}
+
+} // namespace
+
+VectorServer::VectorServer(VectorStore& store, HNSW& index)
+    : store_(store),
+      index_(index),
+      epoll_(::epoll_create1(EPOLL_CLOEXEC)),
+      wake_(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) {
+    if (!epoll_.valid() || !wake_.valid()) {
+        throw eventLoopError("Cannot create event loop");
+    }
+    epollControl(epoll_.get(), EPOLL_CTL_ADD, wake_.get(), EPOLLIN);
+}
+
+VectorServer::~VectorServer() {
+    for (const auto& path : unixPaths_) {
+        ::unlink(path.c_str());
+    }
+}
+
+void VectorServer::listenUnix(const std::string& path) {
+    addListener(atlas::listenUnix(path));
+    unixPaths_.push_back(path);
+}
+
+uint16_t VectorServer::listenTcp(uint16_t port, const std::string& host) {
+    FileDescriptor fd = atlas::listenTcp(host, port);
+    uint16_t bound = localPort(fd.get());
+    addListener(std::move(fd));
+    return bound;
+}
+
+void VectorServer::addListener(FileDescriptor fd) {
+    setNonBlocking(fd.get());
+    epollControl(epoll_.get(), EPOLL_CTL_ADD, fd.get(), EPOLLIN);
+    listeners_.push_back(std::move(fd));
+}
+
+void VectorServer::stop() {
+    // only write(2): callable from a signal handler
+    uint64_t one = 1;
+    ssize_t ignored = ::write(wake_.get(), &one, sizeof(one));
+    (void)ignored;
+}
+
+void VectorServer::run() {
+    epoll_event events[64];
+    while (true) {
+        int ready = ::epoll_wait(epoll_.get(), events, 64, -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw eventLoopError("epoll_wait failed");
+        }
+
+        for (int i = 0; i < ready; i++) {
+            int fd = events[i].data.fd;
+            if (fd == wake_.get()) {
+                uint64_t count;
+                ssize_t ignored = ::read(wake_.get(), &count, sizeof(count));
+                (void)ignored;
+                return;
+            }
+
+            bool isListener = std::any_of(listeners_.begin(), listeners_.end(),
+                                          [fd](const FileDescriptor& l) { return l.get() == fd; });
+            if (isListener) {
+                acceptConnections(fd);
+                continue;
+            }
+
+            auto it = connections_.find(fd);
+            if (it == connections_.end()) {
+                continue;
+            }
+            Connection& conn = it->second;
+            bool keep = true;
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                keep = onReadable(conn);
+            }
+            if (keep && (events[i].events & EPOLLOUT)) {
+                keep = flush(conn);
+            }
+            if (!keep) {
+                closeConnection(fd);
+            }
+        }
+    }
+}
+
+void VectorServer::acceptConnections(int listenFd) {
+    while (true) {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+        if (fd < 0) {
+            return;  // EAGAIN: backlog drained (or a transient accept error)
+        }
+        Connection conn;
+        conn.fd = FileDescriptor(fd);
+        conn.events = EPOLLIN;
+        epollControl(epoll_.get(), EPOLL_CTL_ADD, fd, conn.events);
+        connections_.emplace(fd, std::move(conn));
+    }
+}
+
+void VectorServer::closeConnection(int fd) {
+    ::epoll_ctl(epoll_.get(), EPOLL_CTL_DEL, fd, nullptr);
+    connections_.erase(fd);
+}
+
+bool VectorServer::onReadable(Connection& conn) {
+    // nothing more to read after EOF; under backpressure leave the input
+    // in the socket until responses drain
+    if (conn.peerClosed || conn.pendingOutput() >= kMaxPendingOutput) {
+        return flush(conn);
+    }
+
+    // drain the socket
+    constexpr size_t kReadChunk = 64 * 1024;
+    while (true) {
+        size_t used = conn.in.size();
+        conn.in.resize(used + kReadChunk);
+        ssize_t n = ::read(conn.fd.get(), conn.in.data() + used, kReadChunk);
+        conn.in.resize(used + std::max<ssize_t>(n, 0));
+        if (n > 0) {
+            continue;
+        }
+        if (n == 0) {
+            conn.peerClosed = true;  // still answer what it sent before closing
+            break;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        return false;
+    }
+
+    return flush(conn);
+}
+
+bool VectorServer::answerFrames(Connection& conn) {
+    // answer every complete frame (pipelined requests are handled in order)
+    while (conn.in.size() - conn.inStart >= wire::kHeaderSize &&
+           conn.pendingOutput() < kMaxPendingOutput) {
+        wire::FrameHeader header = wire::decodeHeader(conn.in.data() + conn.inStart);
+        if (header.length > wire::kMaxFrameLength) {
+            return false;  // not our protocol, or corrupted: drop the peer
+        }
+        size_t frameEnd = conn.inStart + wire::kHeaderSize + header.length;
+        if (conn.in.size() < frameEnd) {
+            break;
+        }
+        std::span<const char> payload(conn.in.data() + conn.inStart + wire::kHeaderSize,
+                                      header.length);
+        dispatch(header, payload, conn.out);
+        conn.inStart = frameEnd;
+    }
+
+    // keep only the unanswered frames
+    conn.in.erase(conn.in.begin(), conn.in.begin() + conn.inStart);
+    conn.inStart = 0;
+    return true;
+}
+
+bool VectorServer::flush(Connection& conn) {
+    while (true) {
+        if (!answerFrames(conn)) {
+            return false;
+        }
+        bool limited = conn.pendingOutput() >= kMaxPendingOutput;  // frames may be held back
+
+        bool full = false;
+        while (!full && conn.outStart < conn.out.size()) {
+            ssize_t n = ::send(conn.fd.get(), conn.out.data() + conn.outStart,
+                               conn.out.size() - conn.outStart, MSG_NOSIGNAL);
+            if (n > 0) {
+                conn.outStart += static_cast<size_t>(n);
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                full = true;  // socket buffer full: finish when it drains
+            } else {
+                return false;
+            }
+        }
+
+        if (conn.outStart == conn.out.size()) {
+            conn.out.clear();
+            conn.outStart = 0;
+        } else if (conn.outStart >= kMaxPendingOutput) {
+            conn.out.erase(conn.out.begin(), conn.out.begin() + conn.outStart);
+            conn.outStart = 0;
+        }
+
+        // everything written: requests held back by the limit can run now
+        if (!limited || full) {
+            break;
+        }
+    }
+
+    // every complete frame is answered once the output is empty
+    if (conn.peerClosed && conn.pendingOutput() == 0) {
+        return false;
+    }
+    updateInterest(conn);
+    return true;
+}
+
+void VectorServer::updateInterest(Connection& conn) {
+    uint32_t events = 0;
+    if (!conn.peerClosed && conn.pendingOutput() < kMaxPendingOutput) {
+        events |= EPOLLIN;
+    }
+    if (conn.pendingOutput() > 0) {
+        events |= EPOLLOUT;
+    }
+    if (events != conn.events) {
+        epollControl(epoll_.get(), EPOLL_CTL_MOD, conn.fd.get(), events);
+        conn.events = events;
+    }
+}
+
+void VectorServer::dispatch(const wire::FrameHeader& header, std::span<const char> payload,
+                            std::vector<char>& out) {
+    size_t rollback = out.size();
+    try {
+        wire::FrameReader reader(payload);
+        switch (header.op) {
+            case wire::Op::Search:
+                handleSearch(header.requestId, reader, out);
+                break;
+            case wire::Op::Insert:
+                handleInsert(header.requestId, reader, out);
+                break;
+            case wire::Op::Size: {
+                wire::FrameWriter writer(out, wire::Op::Size, header.requestId);
+                writer.put<uint64_t>(store_.size());
+                writer.finish();
+                break;
+            }
+            default:
+                throw std::invalid_argument("Unknown opcode " +
+                                            std::to_string(static_cast<int>(header.op)));
+        }
+    } catch (const std::exception& e) {
+        // bad request (e.g. dimension mismatch): report it and keep serving
+        out.resize(rollback);
+        std::string message = e.what();
+        wire::FrameWriter writer(out, header.op, header.requestId, wire::Status::Error);
+        writer.putBytes(message.data(), message.size());
+        writer.finish();
+    }
+}
+
+void VectorServer::handleSearch(uint32_t requestId, wire::FrameReader& reader,
+                                std::vector<char>& out) {
+    uint32_t k = reader.get<uint32_t>();
+    uint32_t efSearch = reader.get<uint32_t>();
+    uint32_t dim = reader.get<uint32_t>();
+    uint32_t numQueries = reader.get<uint32_t>();
+    if (dim != store_.getDimension()) {
+        throw std::invalid_argument("Query dimension mismatch: expected " +
+                                    std::to_string(store_.getDimension()) + ", got " +
+                                    std::to_string(dim));
+    }
+    if (reader.remaining() != static_cast<size_t>(numQueries) * dim * sizeof(float)) {
+        throw std::invalid_argument("Search frame size does not match its query count");
+    }
+    // search straight out of the receive buffer; copy only if misaligned
+    size_t count = static_cast<size_t>(numQueries) * dim;
+    std::span<const float> queries = reader.getView<float>(count);
+    if (queries.size() != count) {
+        reader.getArray<float>(count, queries_);
+        queries = queries_;
+    }
+
+    wire::FrameWriter writer(out, wire::Op::Search, requestId);
+    for (uint32_t q = 0; q < numQueries; q++) {
+        auto results = index_.search(queries.subspan(static_cast<size_t>(q) * dim, dim), k,
+                                     efSearch);
+
+        writer.put<uint32_t>(static_cast<uint32_t>(results.size()));
+        for (const auto& result : results) {
+            writer.put<uint64_t>(result.id);
+            writer.put<float>(result.distance);
+        }
+    }
+    writer.finish();
+}
+
+void VectorServer::handleInsert(uint32_t requestId, wire::FrameReader& reader,
+                                std::vector<char>& out) {
+    uint32_t dim = reader.get<uint32_t>();
+    uint32_t numVectors = reader.get<uint32_t>();
+    if (dim != store_.getDimension()) {
+        throw std::invalid_argument("Vector dimension mismatch: expected " +
+                                    std::to_string(store_.getDimension()) + ", got " +
+                                    std::to_string(dim));
+    }
+    size_t expected = static_cast<size_t>(numVectors) * (sizeof(VectorId) + dim * sizeof(float));
+    if (reader.remaining() != expected) {
+        throw std::invalid_argument("Insert frame size does not match its vector count");
+    }
+    reader.getArray<VectorId>(numVectors, ids_);
+    reader.getArray<float>(static_cast<size_t>(numVectors) * dim, data_);
+
+    // reject the batch before any of it is stored: the store checks the
+    // IDs, zero vectors would fail inside the index after the store took
+    // them (and, as entry point, break every later search)
+    for (uint32_t row = 0; row < numVectors; row++) {
+        std::span<const float> vec(data_.data() + static_cast<size_t>(row) * dim, dim);
+        if (isZeroMagnitude(vec)) {
+            throw std::invalid_argument("Vector " + std::to_string(ids_[row]) +
+                                        " has zero magnitude");
+        }
+    }
+    store_.addVectors(ids_, data_);
+    for (VectorId id : ids_) {
+        index_.addVector(id);
+    }
+
+    wire::FrameWriter writer(out, wire::Op::Insert, requestId);
+    writer.put<uint32_t>(numVectors);
+    writer.finish();
+}
+
+} // namespace atlas
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "../common/types.hpp"
+#include "../common/vector_store.hpp"
+#include "../index/hnsw.hpp"
+#include "socket.hpp"
+#include "wire_protocol.hpp"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * VectorServer - Serves an HNSW index over the binary wire protocol
+ *
+ * A single-threaded epoll event loop over any number of Unix domain and
+ * TCP listeners. Sockets are non-blocking; each connection buffers its
+ * input and parses every complete frame in it, so pipelined requests are
+ * answered back to back and their responses leave in one write. Requests
+ * run on the loop thread, which also serializes inserts against searches
+ * (the index itself is not thread-safe for writes).
+ *
+ * Search queries are handed to HNSW::search as views into the receive
+ * buffer (copied once into a reused buffer only if a malformed earlier
+ * frame left them misaligned); insert payloads are copied into reused
+ * ID/data buffers for VectorStore::addVectors. An insert batch is checked
+ * row by row before any of it is stored, so it is applied entirely or
+ * not at all.
+ *
+ * Backpressure: while a connection has more than kMaxPendingOutput bytes
+ * of unsent responses the server stops reading from it and holds back
+ * its buffered requests, so a client that pipelines without reading
+ * cannot grow server memory without bound.
+ */
+class VectorServer {
+public:
+    // Unsent response bytes per connection above which reading pauses
+    static constexpr size_t kMaxPendingOutput = 4u << 20;
+
+    /**
+     * Constructor
+     * @param store Vector storage the index is built on
+     * @param index Index to serve (searched and extended in place)
+     * @throws std::runtime_error if the event loop cannot be created
+     */
+    VectorServer(VectorStore& store, HNSW& index);
+    ~VectorServer();
+
+    VectorServer(const VectorServer&) = delete;
+    VectorServer& operator=(const VectorServer&) = delete;
+
+    /**
+     * Accept connections on a Unix domain socket (file removed on destruction)
+     * @throws std::runtime_error on failure
+     */
+    void listenUnix(const std::string& path);
+
+    /**
+     * Accept connections on a TCP port
+     * @param port Port to bind (0 = any free port)
+     * @param host IPv4 address to bind
+     * @return The bound port
+     * @throws std::runtime_error on failure
+     */
+    uint16_t listenTcp(uint16_t port, const std::string& host = "127.0.0.1");
+
+    /**
+     * Run the event loop until stop() is called
+     * @throws std::runtime_error if epoll fails
+     */
+    void run();
+
+    /**
+     * Make run() return (safe from other threads and signal handlers)
+     */
+    void stop();
+
+private:
+    struct Connection {
+        FileDescriptor fd;
+        std::vector<char> in;   // Received bytes, parsed from inStart
+        size_t inStart = 0;
+        std::vector<char> out;  // Responses not yet written, from outStart
+        size_t outStart = 0;
+        uint32_t events = 0;    // Registered epoll interest
+        bool peerClosed = false;  // Read EOF: answer what is buffered, then close
+
+        size_t pendingOutput() const { return out.size() - outStart; }
+    };
+
+    void addListener(FileDescriptor fd);
+    void acceptConnections(int listenFd);
+    void closeConnection(int fd);
+
+    // Read what is available and answer every complete frame;
+    // false if the connection should be closed
+    bool onReadable(Connection& conn);
+
+    // Write buffered responses, answering held-back requests as the
+    // output drains; false if the connection should be closed (also once
+    // a half-closed peer has been sent every answer)
+    bool flush(Connection& conn);
+
+    // Answer complete frames in conn.in until the output limit is hit;
+    // false on a corrupted frame header
+    bool answerFrames(Connection& conn);
+
+    // Watch for input unless over the output limit or at EOF, for output
+    // while any is pending
+    void updateInterest(Connection& conn);
+
+    // Execute one request, appending its response to out
+    void dispatch(const wire::FrameHeader& header, std::span<const char> payload,
+                  std::vector<char>& out);
+    void handleSearch(uint32_t requestId, wire::FrameReader& reader, std::vector<char>& out);
+    void handleInsert(uint32_t requestId, wire::FrameReader& reader, std::vector<char>& out);
+
+    VectorStore& store_;
+    HNSW& index_;
+
+    FileDescriptor epoll_;
+    FileDescriptor wake_;  // eventfd written by stop()
+    std::vector<FileDescriptor> listeners_;
+    std::vector<std::string> unixPaths_;
+    std::unordered_map<int, Connection> connections_;
+
+    // Request buffers reused across frames
+    std::vector<float> queries_;  // Only for misaligned search payloads
+    std::vector<VectorId> ids_;
+    std::vector<float> data_;
+};
+
+} // namespace atlas
@@ -0,0 +1,44 @@
+#include "wire_protocol.hpp"
+
+namespace atlas {
+
+namespace wire {
+
+FrameWriter::FrameWriter(std::vector<char>& out, Op op, uint32_t requestId, Status status)
+    : out_(out), start_(out.size()) {
+    FrameHeader header{0, requestId, op, status, 0};
+    putBytes(&header, kHeaderSize);
+}
+
+void FrameWriter::putBytes(const void* data, size_t len) {
+    const char* bytes = static_cast<const char*>(data);
+    out_.insert(out_.end(), bytes, bytes + len);
+}
+
+void FrameWriter::finish() {
+    size_t length = out_.size() - start_ - kHeaderSize;
+    if (length > kMaxFrameLength) {
+        throw std::length_error("Frame payload too large: " + std::to_string(length) + " bytes");
+    }
+    uint32_t length32 = static_cast<uint32_t>(length);
+    std::memcpy(out_.data() + start_, &length32, sizeof(length32));
+}
+
+const char* FrameReader::take(size_t len) {
+    if (len > remaining()) {
+        throw std::invalid_argument("Truncated frame payload");
+    }
+    const char* p = data_.data() + pos_;
+    pos_ += len;
+    return p;
+}
+
+FrameHeader decodeHeader(const char* data) {
+    FrameHeader header;
+    std::memcpy(&header, data, kHeaderSize);
+    return header;
+}
+
+} // namespace wire
+
+} // namespace atlas
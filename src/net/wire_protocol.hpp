@@ -0,0 +1,168 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * Binary wire protocol shared by VectorServer and VectorClient
+ *
+ * Every message is a frame: a fixed 12-byte header followed by `length`
+ * payload bytes. All integers and floats are little-endian and packed
+ * (no padding), so float arrays go on the wire as-is and are read in
+ * place or copied straight into query/insert buffers on the other side.
+ * Every request frame is a multiple of 4 bytes long, so the arrays of
+ * pipelined requests stay float-aligned in a receive buffer.
+ *
+ *   header   u32 length | u32 requestId | u8 op | u8 status | u16 reserved
+ *
+ *   Search   request:  u32 k | u32 efSearch | u32 dim | u32 numQueries |
+ *                      f32[numQueries * dim]
+ *            response: per query: u32 count | count * (u64 id | f32 distance)
+ *   Insert   request:  u32 dim | u32 numVectors | u64[numVectors] ids |
+ *                      f32[numVectors * dim]
+ *            response: u32 numVectors
+ *   Size     request:  (empty)
+ *            response: u64 size
+ *
+ * A response carries the op and requestId of its request. Requests on one
+ * connection are answered in order, so clients may pipeline: send several
+ * frames, then read the responses. An error response has status Error and
+ * the message text as payload.
+ */
+namespace wire {
+
+static_assert(std::endian::native == std::endian::little,
+              "wire protocol copies little-endian values as-is");
+
+enum class Op : uint8_t { Search = 1, Insert = 2, Size = 3 };
+
+enum class Status : uint8_t { Ok = 0, Error = 1 };
+
+struct FrameHeader {
+    uint32_t length;     // Payload bytes after the header
+    uint32_t requestId;  // Chosen by the client, echoed in the response
+    Op op;
+    Status status;
+    uint16_t reserved;
+};
+
+constexpr size_t kHeaderSize = 12;
+static_assert(sizeof(FrameHeader) == kHeaderSize);
+
+// Largest payload either side accepts (guards against garbage lengths)
+constexpr uint32_t kMaxFrameLength = 256u << 20;
+
+// Bytes per search result on the wire (u64 id + f32 distance)
+constexpr size_t kResultSize = 12;
+
+/**
+ * Appends one frame to a byte buffer
+ *
+ * The header is written by the constructor with a zero length and patched
+ * by finish(), so the payload can be built in place without a copy.
+ */
+class FrameWriter {
+public:
+    FrameWriter(std::vector<char>& out, Op op, uint32_t requestId, Status status = Status::Ok);
+
+    template <typename T>
+    void put(const T& value) {
+        putBytes(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void putArray(std::span<const T> values) {
+        putBytes(values.data(), values.size_bytes());
+    }
+
+    void putBytes(const void* data, size_t len);
+
+    /**
+     * Write the final payload length into the header
+     * @throws std::length_error if the payload exceeds kMaxFrameLength
+     */
+    void finish();
+
+private:
+    std::vector<char>& out_;
+    size_t start_;
+};
+
+/**
+ * Bounds-checked reader over one frame payload
+ *
+ * Reading past the end throws std::invalid_argument (a malformed request
+ * is the client's error, like any other bad argument).
+ */
+class FrameReader {
+public:
+    explicit FrameReader(std::span<const char> payload) : data_(payload) {}
+
+    template <typename T>
+    T get() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    // Copy count values into out (resized)
+    template <typename T>
+    void getArray(size_t count, std::vector<T>& out) {
+        if (count > remaining() / sizeof(T)) {
+            throw std::invalid_argument("Truncated frame payload");
+        }
+        out.resize(count);
+        std::memcpy(out.data(), take(count * sizeof(T)), count * sizeof(T));
+    }
+
+    /**
+     * View count values in place instead of copying them
+     * @return The values, or an empty span (nothing consumed) if the
+     *         bytes are not aligned for T; then read them with getArray
+     * @throws std::invalid_argument if fewer than count values remain
+     */
+    template <typename T>
+    std::span<const T> getView(size_t count) {
+        if (count > remaining() / sizeof(T)) {
+            throw std::invalid_argument("Truncated frame payload");
+        }
+        const char* bytes = data_.data() + pos_;
+        if (reinterpret_cast<uintptr_t>(bytes) % alignof(T) != 0) {
+            return {};
+        }
+        take(count * sizeof(T));
+        return std::span<const T>(reinterpret_cast<const T*>(bytes), count);
+    }
+
+    size_t remaining() const { return data_.size() - pos_; }
+
+    // Rest of the payload as text (error messages)
+    std::string rest() {
+        size_t len = remaining();
+        return std::string(take(len), len);
+    }
+
+private:
+    const char* take(size_t len);
+
+    std::span<const char> data_;
+    size_t pos_ = 0;
+};
+
+/**
+ * Decode a frame header from the start of a buffer
+ * @param data At least kHeaderSize bytes
+ */
+FrameHeader decodeHeader(const char* data);
+
+} // namespace wire
+
+} // namespace atlas
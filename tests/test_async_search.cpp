@@ -0,0 +1,133 @@
+#include "index/async_search.hpp"
+#include "common/thread_pool.hpp"
+#include "common/vector_store.hpp"
+#include <iostream>
+#include <cassert>
+#include <random>
+
+using namespace std::chrono_literals;
+
+// Random store + index shared by the tests below
+struct Fixture {
+    atlas::VectorStore store;
+    atlas::HNSW hnsw;
+    atlas::Vector query;
+
+    Fixture() : store(16), hnsw(store, 8, 50), query(16) {
+        std::mt19937 rng(9);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        for (size_t i = 1; i <= 300; i++) {
+            atlas::Vector vec(16);
+            for (auto& v : vec) {
+                v = dist(rng);
+            }
+            store.addVector(i, vec);
+            hnsw.addVector(i);
+        }
+        for (auto& v : query) {
+            v = dist(rng);
+        }
+    }
+};
+
+void testThreadPool() {
+    std::cout << "Test 1: Work-Stealing Pool... ";
+    
+    atlas::ThreadPool pool(4);
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 100; i++) {
+        futures.push_back(pool.submit([i]() { return i * i; }));
+    }
+    int sum = 0;
+    for (auto& f : futures) {
+        sum += f.get();
+    }
+    assert(sum == 328350);
+    
+    // Tasks can spawn tasks, and exceptions reach the caller
+    auto nested = pool.submit([&pool]() { return pool.submit([]() { return 7; }).get(); });
+    assert(nested.get() == 7);
+    auto failing = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+    bool exceptionThrown = false;
+    try {
+        failing.get();
+    } catch (const std::runtime_error& e) {
+        exceptionThrown = true;
+    }
+    assert(exceptionThrown);
+    
+    std::cout << "PASSED" << std::endl;
+}
+
+void testCompletesBeforeDeadline() {
+    std::cout << "Test 2: Completes Before Deadline... ";
+    
+    Fixture f;
+    atlas::AsyncSearcher searcher(f.hnsw, 2);
+    
+    auto result = searcher.submit(f.query, 5, 50, 10s).get();
+    auto expected = f.hnsw.search(f.query, 5, 50);
+    
+    assert(!result.stats.truncated && !result.stats.cancelled);
+    assert(result.results.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        assert(result.results[i].id == expected[i].id);
+    }
+    
+    std::cout << "PASSED" << std::endl;
+}
+
+void testExpiredDeadline() {
+    std::cout << "Test 3: Expired Deadline... ";
+    
+    Fixture f;
+    atlas::AsyncSearcher searcher(f.hnsw, 1);
+    
+    auto result = searcher.submit(f.query, 5, 50,
+                                  std::chrono::steady_clock::now() - 1ms).get();
+    assert(result.expiredInQueue);
+    assert(result.stats.truncated);
+    assert(result.results.empty());
+    assert(result.stats.distanceComputations == 0);
+    
+    std::cout << "PASSED" << std::endl;
+}
+
+void testCancellation() {
+    std::cout << "Test 4: Cooperative Cancellation... ";
+    
+    Fixture f;
+    
+    // Token raised before the query runs: nothing is computed
+    atlas::AsyncSearcher searcher(f.hnsw, 1);
+    atlas::CancellationToken token;
+    token.cancel();
+    auto result = searcher.submit(f.query, 5, 50, 10s, token).get();
+    assert(result.stats.cancelled);
+    assert(result.stats.distanceComputations == 0);
+    
+    // Flag polled inside the search loop returns partial results
+    std::atomic<bool> cancel{true};
+    atlas::SearchBudget budget;
+    budget.cancel = &cancel;
+    atlas::SearchStats stats;
+    auto partial = f.hnsw.search(f.query, 5, 50, budget, &stats);
+    assert(stats.cancelled);
+    assert(!partial.empty());
+    assert(stats.expansions == 0);
+    
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "\n=== Async Search Tests ===" << std::endl;
+    
+    testThreadPool();
+    testCompletesBeforeDeadline();
+    testExpiredDeadline();
+    testCancellation();
+    
+    std::cout << "All tests passed!" << std::endl;
+    
+    return 0;
+}
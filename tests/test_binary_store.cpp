@@ -0,0 +1,120 @@
+#include "../src/common/binary_store.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+using namespace atlas;
+
+void testEncode() {
+  std::cout << "Testing sign-bit encoding... ";
+
+  Vector vec(70, -1.0f);
+  vec[0] = 0.5f;
+  vec[63] = 2.0f;
+  vec[64] = 0.1f;
+  vec[69] = 3.0f;
+
+  uint64_t code[2];
+  BinaryStore::encode(vec, code);
+  assert(code[0] == ((uint64_t(1) << 0) | (uint64_t(1) << 63)));
+  assert(code[1] == ((uint64_t(1) << 0) | (uint64_t(1) << 5)));
+
+  std::cout << "PASSED" << std::endl;
+}
+
+void testHammingAndRerank() {
+  std::cout << "Testing Hamming pre-filter and re-rank... ";
+
+  VectorStore store(4);
+  store.addVector(1, {1.0f, 1.0f, 1.0f, 1.0f});
+  store.addVector(2, {1.0f, 1.0f, 1.0f, -1.0f});
+  store.addVector(3, {-1.0f, -1.0f, -1.0f, -1.0f});
+  store.addVector(4, {0.9f, 1.1f, 1.0f, 1.0f});
+
+  BinaryStore codes(store);
+  assert(codes.size() == 4);
+  assert(codes.wordsPerCode() == 1);
+
+  Vector query = {1.0f, 1.0f, 1.0f, 1.0f};
+
+  // IDs 1 and 4 share the query's code exactly
+  auto candidates = codes.hammingSearch(query, 2);
+  assert(candidates.size() == 2);
+  assert(candidates[0].distance == 0.0f && candidates[1].distance == 0.0f);
+
+  // Re-rank breaks the tie with the exact distance
+  auto results = codes.search(query, 1, 2);
+  assert(results.size() == 1);
+  assert(results[0].id == 1);
+  assert(std::abs(results[0].distance) < 1e-5f);
+
+  // New store vectors are picked up by sync()
+  store.addVector(5, {-1.0f, 1.0f, 1.0f, 1.0f});
+  codes.sync();
+  assert(codes.size() == 5);
+
+  std::cout << "PASSED" << std::endl;
+}
+
+void testRecallAgainstBruteForce() {
+  std::cout << "Testing recall vs brute force... ";
+
+  const size_t dim = 256;
+  const size_t count = 2000;
+  const size_t k = 10;
+
+  std::mt19937 rng(8);
+  std::normal_distribution<float> dist(0.0f, 1.0f);
+  VectorStore store(dim);
+  for (size_t i = 0; i < count; i++) {
+    Vector vec(dim);
+    for (auto &v : vec) {
+      v = dist(rng);
+    }
+    store.addVector(i, vec);
+  }
+  BinaryStore codes(store);
+  assert(codes.codeBytes() * 32 == count * dim * sizeof(float));
+
+  // Queries near stored vectors, as in near-duplicate lookups
+  size_t hits = 0;
+  for (size_t q = 0; q < 20; q++) {
+    VectorView base = store.getVector(q * 50);
+    Vector query(base.begin(), base.end());
+    for (auto &v : query) {
+      v += 0.3f * dist(rng);
+    }
+    auto approx = codes.search(query, k, 10);
+    auto exact = store.bruteForceSearch(query, k);
+    for (const auto &a : approx) {
+      for (const auto &e : exact) {
+        if (a.id == e.id) {
+          hits++;
+          break;
+        }
+      }
+    }
+  }
+  float recall = static_cast<float>(hits) / (20 * k);
+  std::cout << "Recall@" << k << " = " << recall << " ";
+  assert(recall >= 0.5f);
+
+  std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+  std::cout << "========================================" << std::endl;
+  std::cout << "  BinaryStore Unit Tests" << std::endl;
+  std::cout << "========================================" << std::endl;
+
+  testEncode();
+  testHammingAndRerank();
+  testRecallAgainstBruteForce();
+
+  std::cout << "========================================" << std::endl;
+  std::cout << "All tests passed!" << std::endl;
+  std::cout << "========================================" << std::endl;
+
+  return 0;
+}
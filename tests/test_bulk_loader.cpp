@@ -0,0 +1,236 @@
+#include "../src/io/bulk_loader.hpp"
+#include "../src/distance/distance.hpp"
+#include "../src/index/hnsw.hpp"
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace atlas;
+
+// Helper function to compare floats with tolerance
+bool approxEqual(float a, float b, float epsilon = 1e-5f) {
+  return std::abs(a - b) < epsilon;
+}
+
+// Temp file path for this test run
+std::string tempPath(const std::string &name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Row i of the test data: {i + 1, 2 * (i + 1), 0, 1}
+Vector testRow(size_t i) {
+  float v = static_cast<float>(i + 1);
+  return {v, 2.0f * v, 0.0f, 1.0f};
+}
+
+void writeFvecs(const std::string &path, size_t count) {
+  std::ofstream out(path, std::ios::binary);
+  for (size_t i = 0; i < count; i++) {
+    Vector row = testRow(i);
+    int32_t dim = static_cast<int32_t>(row.size());
+    out.write(reinterpret_cast<const char *>(&dim), sizeof(dim));
+    out.write(reinterpret_cast<const char *>(row.data()),
+              row.size() * sizeof(float));
+  }
+}
+
+// Writes count test rows; shape defaults to the true "(count, 4)"
+void writeNpy(const std::string &path, size_t count,
+              const std::string &shape = "") {
+  std::string header =
+      "{'descr': '<f4', 'fortran_order': False, 'shape': " +
+      (shape.empty() ? "(" + std::to_string(count) + ", 4)" : shape) + ", }";
+  // Pad so the data starts on a 64-byte boundary, newline-terminated
+  while ((10 + header.size() + 1) % 64 != 0) {
+    header += ' ';
+  }
+  header += '\n';
+
+  std::ofstream out(path, std::ios::binary);
+  out.write("\x93NUMPY\x01\x00", 8);
+  uint16_t len = static_cast<uint16_t>(header.size());
+  out.write(reinterpret_cast<const char *>(&len), sizeof(len));
+  out.write(header.data(), header.size());
+  for (size_t i = 0; i < count; i++) {
+    Vector row = testRow(i);
+    out.write(reinterpret_cast<const char *>(row.data()),
+              row.size() * sizeof(float));
+  }
+}
+
+void writeRaw(const std::string &path, size_t count) {
+  std::ofstream out(path, std::ios::binary);
+  for (size_t i = 0; i < count; i++) {
+    Vector row = testRow(i);
+    out.write(reinterpret_cast<const char *>(row.data()),
+              row.size() * sizeof(float));
+  }
+}
+
+// Every loaded row matches testRow (ids start at firstId)
+void checkRows(const VectorStore &store, size_t count, VectorId firstId) {
+  assert(store.size() == count);
+  for (size_t i = 0; i < count; i++) {
+    VectorView row = store.getVector(firstId + i);
+    Vector expected = testRow(i);
+    for (size_t j = 0; j < expected.size(); j++) {
+      assert(approxEqual(row[j], expected[j]));
+    }
+  }
+}
+
+void testDetectFormat() {
+  std::cout << "Testing format detection... ";
+
+  assert(detectFormat("base.fvecs") == VectorFileFormat::Fvecs);
+  assert(detectFormat("/data/emb.npy") == VectorFileFormat::Npy);
+  assert(detectFormat("vectors.bin") == VectorFileFormat::RawFloat32);
+
+  std::cout << "PASSED" << std::endl;
+}
+
+void testLoadFvecs() {
+  std::cout << "Testing .fvecs load across chunks... ";
+
+  std::string path = tempPath("atlas_test_load.fvecs");
+  writeFvecs(path, 1000);
+
+  VectorStore store(4);
+  BulkLoadOptions options;
+  options.firstId = 10;
+  options.chunkSize = 64; // Force many chunks in flight
+  options.numThreads = 4;
+  BulkLoadStats stats = bulkLoad(path, store, options);
+
+  assert(stats.vectorsLoaded == 1000);
+  assert(stats.bytesRead == 1000 * (4 + 4 * sizeof(float)));
+  checkRows(store, 1000, 10);
+
+  std::filesystem::remove(path);
+  std::cout << "PASSED" << std::endl;
+}
+
+void testLoadNpy() {
+  std::cout << "Testing .npy load... ";
+
+  std::string path = tempPath("atlas_test_load.npy");
+  writeNpy(path, 300);
+
+  VectorStore store(4);
+  BulkLoadStats stats = bulkLoad(path, store);
+
+  assert(stats.vectorsLoaded == 300);
+  checkRows(store, 300, 0);
+
+  std::filesystem::remove(path);
+  std::cout << "PASSED" << std::endl;
+}
+
+void testMalformedNpyShape() {
+  std::cout << "Testing .npy shape validation... ";
+
+  std::string path = tempPath("atlas_test_shape.npy");
+  // 3-D, 1-D, a shape that leaves trailing data, and one the data is short of
+  for (const char *shape : {"(6, 2, 2)", "(24,)", "(5, 4)", "(7, 4)"}) {
+    writeNpy(path, 6, shape);
+    VectorStore store(2);
+    bool exceptionThrown = false;
+    try {
+      bulkLoad(path, store);
+    } catch (const std::runtime_error &e) {
+      exceptionThrown = true;
+    }
+    assert(exceptionThrown);
+    assert(store.size() == 0);
+  }
+
+  std::filesystem::remove(path);
+  std::cout << "PASSED" << std::endl;
+}
+
+void testLoadRawNormalizedIntoIndex() {
+  std::cout << "Testing raw load with normalization and indexing... ";
+
+  std::string path = tempPath("atlas_test_load.bin");
+  writeRaw(path, 200);
+
+  VectorStore store(4);
+  HNSW hnsw(store, 8, 50);
+  BulkLoadOptions options;
+  options.chunkSize = 50;
+  options.normalize = true;
+  bulkLoad(path, store, options, &hnsw);
+
+  assert(store.size() == 200);
+  for (size_t i = 0; i < 200; i++) {
+    assert(approxEqual(magnitude(store.getVector(i)), 1.0f));
+  }
+
+  // Vectors went into the index as well
+  Vector query = testRow(42);
+  auto results = hnsw.search(query, 1, 50);
+  assert(!results.empty());
+  assert(approxEqual(results[0].distance, 0.0f, 1e-4f));
+
+  std::filesystem::remove(path);
+  std::cout << "PASSED" << std::endl;
+}
+
+void testDimensionMismatch() {
+  std::cout << "Testing dimension mismatch... ";
+
+  std::string path = tempPath("atlas_test_mismatch.fvecs");
+  writeFvecs(path, 10);
+
+  VectorStore store(8);
+  bool exceptionThrown = false;
+  try {
+    bulkLoad(path, store);
+  } catch (const std::invalid_argument &e) {
+    exceptionThrown = true;
+  }
+  assert(exceptionThrown);
+  assert(store.size() == 0);
+
+  std::filesystem::remove(path);
+  std::cout << "PASSED" << std::endl;
+}
+
+void testMissingFile() {
+  std::cout << "Testing missing file... ";
+
+  VectorStore store(4);
+  bool exceptionThrown = false;
+  try {
+    bulkLoad(tempPath("atlas_does_not_exist.fvecs"), store);
+  } catch (const std::runtime_error &e) {
+    exceptionThrown = true;
+  }
+  assert(exceptionThrown);
+
+  std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+  std::cout << "========================================" << std::endl;
+  std::cout << "  Bulk Loader Unit Tests" << std::endl;
+  std::cout << "========================================" << std::endl;
+
+  testDetectFormat();
+  testLoadFvecs();
+  testLoadNpy();
+  testMalformedNpyShape();
+  testLoadRawNormalizedIntoIndex();
+  testDimensionMismatch();
+  testMissingFile();
+
+  std::cout << "========================================" << std::endl;
+  std::cout << "All tests passed!" << std::endl;
+  std::cout << "========================================" << std::endl;
+
+  return 0;
+}
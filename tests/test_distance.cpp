@@ -2,6 +2,7 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <random>
 
 using namespace atlas;
 
@@ -18,6 +19,22 @@ int main() {
 
     float result2 = magnitude(v1);
     assert(approxEqual(result2, std::sqrt(14.0f)));
+
+    // fixed-dimension kernels agree with the generic path
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (size_t dim : {3, 100, 128, 384, 768, 1536}) {
+        std::vector<float> a(dim), b(dim);
+        for (size_t i = 0; i < dim; i++) {
+            a[i] = dist(rng);
+            b[i] = dist(rng);
+        }
+        CosineDistanceFn kernel = selectCosineDistance(dim);
+        assert(hasFixedDimensionKernel(dim) == (dim % 128 == 0));
+        assert(approxEqual(kernel(a.data(), b.data(), dim),
+                           cosineDistanceGeneric(a.data(), b.data(), dim), 1e-4f));
+        assert(approxEqual(kernel(a.data(), a.data(), dim), 0.0f, 1e-4f));
+    }
     
     std::cout << "All tests passed!" << std::endl;
     return 0;
@@ -1,9 +1,11 @@
 #include "index/hnsw.hpp"
 #include "common/vector_store.hpp"
 #include "distance/distance.hpp"
+#include "common/thread_pool.hpp"
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <memory>
 #include <random>
 
 void testBasicConstruction() {
@@ -132,6 +134,330 @@ void testSearchRecall() {
     std::cout << "PASSED" << std::endl;
 }
 
+void testAdaptiveSearch() {
+    std::cout << "Test 6: Adaptive Search Budgets... ";
+    
+    const size_t dim = 16;
+    const size_t numVectors = 200;
+    
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    
+    atlas::VectorStore store(dim);
+    for (size_t i = 1; i <= numVectors; i++) {
+        atlas::Vector vec(dim);
+        for (size_t j = 0; j < dim; j++) {
+            vec[j] = dist(rng);
+        }
+        store.addVector(i, vec);
+    }
+    
+    atlas::HNSW hnsw(store, 8, 50);
+    for (size_t i = 1; i <= numVectors; i++) {
+        hnsw.addVector(i);
+    }
+    
+    atlas::Vector query(dim);
+    for (size_t j = 0; j < dim; j++) {
+        query[j] = dist(rng);
+    }
+    
+    // No limits: identical to the fixed-ef search
+    atlas::SearchStats stats;
+    auto fixed = hnsw.search(query, 5, 50);
+    auto unlimited = hnsw.search(query, 5, 50, atlas::SearchBudget{}, &stats);
+    assert(fixed.size() == unlimited.size());
+    for (size_t i = 0; i < fixed.size(); i++) {
+        assert(fixed[i].id == unlimited[i].id);
+    }
+    assert(!stats.truncated && !stats.converged);
+    assert(stats.distanceComputations > 0);
+    
+    // Distance budget: stops early and reports truncation
+    atlas::SearchBudget capped;
+    capped.maxDistanceComputations = 20;
+    auto partial = hnsw.search(query, 5, 50, capped, &stats);
+    assert(stats.truncated);
+    assert(stats.distanceComputations <= 20);
+    assert(!partial.empty());
+    
+    // Patience: converges without hitting a hard budget
+    atlas::SearchBudget patient;
+    patient.patience = 3;
+    hnsw.search(query, 5, 200, patient, &stats);
+    assert(stats.converged && !stats.truncated);
+    
+    std::cout << "PASSED" << std::endl;
+}
+
+void testRangeSearch() {
+    std::cout << "Test 7: Range Search vs Brute Force... ";
+    
+    const size_t dim = 16;
+    const size_t numVectors = 300;
+    const float radius = 0.6f;
+    
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    
+    atlas::VectorStore store(dim);
+    for (size_t i = 1; i <= numVectors; i++) {
+        atlas::Vector vec(dim);
+        for (size_t j = 0; j < dim; j++) {
+            vec[j] = dist(rng);
+        }
+        store.addVector(i, vec);
+    }
+    
+    atlas::HNSW hnsw(store, 16, 100);
+    for (size_t i = 1; i <= numVectors; i++) {
+        hnsw.addVector(i);
+    }
+    
+    atlas::VectorView row = store.getVector(1);
+    atlas::Vector query(row.begin(), row.end());
+    auto hnswResults = hnsw.rangeSearch(query, radius, 32);
+    auto bruteResults = store.rangeSearch(query, radius);
+    
+    // Every hit must be inside the radius, sorted, and the exact match first
+    assert(!hnswResults.empty());
+    assert(hnswResults.id(0) == 1);
+    for (size_t i = 0; i < hnswResults.size(); i++) {
+        assert(hnswResults.distance(i) <= radius);
+        if (i > 0) {
+            assert(hnswResults.distance(i - 1) <= hnswResults.distance(i));
+        }
+    }
+    
+    float recall = static_cast<float>(hnswResults.size()) / bruteResults.size();
+    std::cout << "Recall = " << recall << " ";
+    assert(recall >= 0.8f && "Range search should find most matches");
+    
+    std::cout << "PASSED" << std::endl;
+}
+
+void testReorderForLocality() {
+    std::cout << "Test 8: Reorder For Locality... ";
+    
+    const size_t dim = 16;
+    const size_t numVectors = 200;
+    
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    
+    atlas::VectorStore store(dim);
+    for (size_t i = 1; i <= numVectors; i++) {
+        atlas::Vector vec(dim);
+        for (size_t j = 0; j < dim; j++) {
+            vec[j] = dist(rng);
+        }
+        store.addVector(i, vec);
+    }
+    
+    atlas::HNSW hnsw(store, 8, 50);
+    for (size_t i = 1; i <= numVectors; i++) {
+        hnsw.addVector(i);
+    }
+    
+    atlas::Vector query(dim);
+    for (size_t j = 0; j < dim; j++) {
+        query[j] = dist(rng);
+    }
+    auto before = hnsw.search(query, 10, 50);
+    atlas::VectorView row = store.getVector(17);
+    atlas::Vector vec17(row.begin(), row.end());
+    
+    auto order = hnsw.localityOrder();
+    assert(order.size() == numVectors);
+    
+    hnsw.reorderForLocality();
+    
+    // Arena now follows the locality order
+    auto ids = store.ids();
+    for (size_t i = 0; i < numVectors; i++) {
+        assert(ids[i] == order[i]);
+    }
+    
+    // IDs, data and results are unchanged
+    row = store.getVector(17);
+    for (size_t j = 0; j < dim; j++) {
+        assert(row[j] == vec17[j]);
+    }
+    auto after = hnsw.search(query, 10, 50);
+    assert(before.size() == after.size());
+    for (size_t i = 0; i < before.size(); i++) {
+        assert(before[i].id == after[i].id);
+    }
+    
+    std::cout << "PASSED" << std::endl;
+}
+
+void testMergePartitions() {
+    std::cout << "Test 9: Merge Partition Graphs... ";
+    
+    const size_t dim = 16;
+    const size_t numVectors = 300;
+    const size_t numParts = 3;
+    const size_t k = 10;
+    
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    
+    atlas::VectorStore store(dim);
+    for (size_t i = 1; i <= numVectors; i++) {
+        atlas::Vector vec(dim);
+        for (size_t j = 0; j < dim; j++) {
+            vec[j] = dist(rng);
+        }
+        store.addVector(i, vec);
+    }
+    
+    // Build one graph per partition (ids round-robin over partitions)
+    std::vector<std::unique_ptr<atlas::HNSW>> parts;
+    std::vector<const atlas::HNSW*> partPtrs;
+    for (size_t p = 0; p < numParts; p++) {
+        parts.push_back(std::make_unique<atlas::HNSW>(store, 16, 100));
+        partPtrs.push_back(parts.back().get());
+    }
+    for (size_t i = 1; i <= numVectors; i++) {
+        parts[i % numParts]->addVector(i);
+    }
+    
+    atlas::ThreadPool pool(2);
+    atlas::HNSW merged(store, 16, 100);
+    merged.merge(partPtrs, pool);
+    assert(merged.localityOrder().size() == numVectors);
+    
+    // Merged graph answers across partitions
+    size_t hits = 0;
+    const size_t numQueries = 20;
+    for (size_t q = 0; q < numQueries; q++) {
+        atlas::Vector query(dim);
+        for (size_t j = 0; j < dim; j++) {
+            query[j] = dist(rng);
+        }
+        auto results = merged.search(query, k, 64);
+        auto truth = store.bruteForceSearch(query, k);
+        for (const auto& r : results) {
+            for (const auto& t : truth) {
+                if (r.id == t.id) {
+                    hits++;
+                    break;
+                }
+            }
+        }
+    }
+    float recall = static_cast<float>(hits) / (numQueries * k);
+    std::cout << "Recall@" << k << " = " << recall << " ";
+    assert(recall >= 0.8f && "Merged recall should be at least 80%");
+    
+    // Target must be empty, partitions must be disjoint
+    bool threw = false;
+    try {
+        merged.merge(partPtrs, pool);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    threw = false;
+    atlas::HNSW target(store, 16, 100);
+    try {
+        target.merge({partPtrs[0], partPtrs[0]}, pool);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    std::cout << "PASSED" << std::endl;
+}
+
+void testEntryPointSeeding() {
+    std::cout << "Test 10: Multi-Entry-Point Seeding... ";
+    
+    const size_t dim = 16;
+    const size_t numClusters = 20;
+    const size_t perCluster = 50;
+    const size_t k = 10;
+    
+    std::mt19937 rng(10);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::normal_distribution<float> noise(0.0f, 0.05f);
+    
+    // Clustered data: points scattered tightly around random centers
+    atlas::VectorStore store(dim);
+    std::vector<atlas::Vector> centers(numClusters, atlas::Vector(dim));
+    for (auto& center : centers) {
+        for (size_t j = 0; j < dim; j++) {
+            center[j] = dist(rng);
+        }
+    }
+    atlas::VectorId nextId = 1;
+    for (size_t i = 0; i < perCluster; i++) {
+        for (const auto& center : centers) {
+            atlas::Vector vec(dim);
+            for (size_t j = 0; j < dim; j++) {
+                vec[j] = center[j] + noise(rng);
+            }
+            store.addVector(nextId++, vec);
+        }
+    }
+    
+    atlas::HNSW hnsw(store, 8, 50);
+    for (atlas::VectorId id = 1; id < nextId; id++) {
+        hnsw.addVector(id);
+    }
+    assert(hnsw.numEntryPoints() == 0);
+    
+    const size_t numQueries = 40;
+    std::vector<atlas::Vector> queries;
+    for (size_t q = 0; q < numQueries; q++) {
+        atlas::Vector query(dim);
+        for (size_t j = 0; j < dim; j++) {
+            query[j] = centers[q % numClusters][j] + noise(rng);
+        }
+        queries.push_back(query);
+    }
+    
+    uint64_t generation = hnsw.generation();
+    hnsw.buildEntryPoints(numClusters, 3);
+    assert(hnsw.numEntryPoints() > 1 && hnsw.numEntryPoints() <= numClusters);
+    assert(hnsw.generation() > generation);  // cached results are stale
+    
+    // Seeding starts every query inside its own cluster, so the best
+    // result comes from the cluster the query was drawn around
+    size_t inCluster = 0;
+    for (size_t q = 0; q < numQueries; q++) {
+        auto results = hnsw.search(queries[q], k, 16);
+        assert(!results.empty());
+        if ((results[0].id - 1) % numClusters == q % numClusters) {
+            inCluster++;
+        }
+    }
+    std::cout << "In-cluster top-1 = " << inCluster << "/" << numQueries << " ";
+    assert(inCluster >= numQueries * 9 / 10 && "Seeded search should start in the right cluster");
+    
+    // Adaptive search charges the entry-point scan to the budget
+    atlas::SearchStats stats;
+    hnsw.search(queries[0], k, 16, atlas::SearchBudget{}, &stats);
+    assert(stats.distanceComputations >= hnsw.numEntryPoints());
+    
+    generation = hnsw.generation();
+    hnsw.clearEntryPoints();
+    assert(hnsw.numEntryPoints() == 0);
+    assert(hnsw.generation() > generation);
+    
+    bool threw = false;
+    try {
+        hnsw.buildEntryPoints(0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    std::cout << "PASSED" << std::endl;
+}
+
 int main() {
     std::cout << "\n=== HNSW Index Tests ===" << std::endl;
     
@@ -140,6 +466,11 @@ int main() {
     testMultipleInsertions();
     testBasicSearch();
     testSearchRecall();
+    testAdaptiveSearch();
+    testRangeSearch();
+    testReorderForLocality();
+    testMergePartitions();
+    testEntryPointSeeding();
     
     std::cout << "All tests passed!" << std::endl;
     
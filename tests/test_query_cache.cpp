@@ -0,0 +1,109 @@
+#include "index/query_cache.hpp"
+#include "index/hnsw.hpp"
+#include "common/vector_store.hpp"
+#include <iostream>
+#include <cassert>
+#include <random>
+
+void testHitAndMiss() {
+    std::cout << "Test 1: Hit And Miss... ";
+    
+    atlas::QueryCache cache(8, 2);
+    atlas::Vector query = {1.0f, 0.0f, 0.0f};
+    std::vector<atlas::VectorWithDistance> out;
+    
+    assert(!cache.lookup(query, 1, 10, 0, out));
+    cache.insert(query, 1, 10, 0, {{7, 0.0f}});
+    assert(cache.lookup(query, 1, 10, 0, out));
+    assert(out.size() == 1 && out[0].id == 7);
+    
+    // Different k or ef is a different entry
+    assert(!cache.lookup(query, 2, 10, 0, out));
+    assert(!cache.lookup(query, 1, 20, 0, out));
+    
+    auto stats = cache.stats();
+    assert(stats.hits == 1);
+    assert(stats.misses == 3);
+    
+    std::cout << "PASSED" << std::endl;
+}
+
+void testNearDuplicateQueries() {
+    std::cout << "Test 2: Near-Duplicate Queries... ";
+    
+    atlas::QueryCache cache(8, 1, 0.01f);
+    std::vector<atlas::VectorWithDistance> out;
+    
+    cache.insert({0.5f, 0.25f}, 1, 10, 0, {{3, 0.1f}});
+    
+    // Rounds to the same grid cell
+    assert(cache.lookup({0.501f, 0.2499f}, 1, 10, 0, out));
+    assert(out[0].id == 3);
+    
+    // Outside the cell
+    assert(!cache.lookup({0.52f, 0.25f}, 1, 10, 0, out));
+    
+    std::cout << "PASSED" << std::endl;
+}
+
+void testGenerationInvalidation() {
+    std::cout << "Test 3: Generation Invalidation... ";
+    
+    atlas::VectorStore store(3);
+    store.addVector(1, {1.0f, 0.0f, 0.0f});
+    store.addVector(2, {0.0f, 1.0f, 0.0f});
+    store.addVector(3, {0.9f, 0.1f, 0.0f});
+    
+    atlas::HNSW hnsw(store, 4, 50);
+    hnsw.addVector(1);
+    hnsw.addVector(2);
+    
+    atlas::QueryCache cache(16);
+    atlas::Vector query = {0.9f, 0.1f, 0.0f};
+    
+    auto first = cache.search(hnsw, query, 1, 10);
+    auto second = cache.search(hnsw, query, 1, 10);
+    assert(first[0].id == 1 && second[0].id == 1);
+    assert(cache.stats().hits == 1);
+    
+    // Insert bumps the generation: the cached answer must not be reused
+    hnsw.addVector(3);
+    auto third = cache.search(hnsw, query, 1, 10);
+    assert(third[0].id == 3);
+    assert(cache.stats().stale == 1);
+    
+    std::cout << "PASSED" << std::endl;
+}
+
+void testLruEviction() {
+    std::cout << "Test 4: LRU Eviction... ";
+    
+    atlas::QueryCache cache(2, 1);
+    std::vector<atlas::VectorWithDistance> out;
+    
+    cache.insert({1.0f}, 1, 1, 0, {{1, 0.0f}});
+    cache.insert({2.0f}, 1, 1, 0, {{2, 0.0f}});
+    assert(cache.lookup({1.0f}, 1, 1, 0, out));  // 1 is now most recent
+    cache.insert({3.0f}, 1, 1, 0, {{3, 0.0f}});  // evicts 2
+    
+    assert(cache.size() == 2);
+    assert(cache.lookup({1.0f}, 1, 1, 0, out));
+    assert(!cache.lookup({2.0f}, 1, 1, 0, out));
+    assert(cache.lookup({3.0f}, 1, 1, 0, out));
+    assert(cache.stats().evictions == 1);
+    
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "\n=== Query Cache Tests ===" << std::endl;
+    
+    testHitAndMiss();
+    testNearDuplicateQueries();
+    testGenerationInvalidation();
+    testLruEviction();
+    
+    std::cout << "All tests passed!" << std::endl;
+    
+    return 0;
+}
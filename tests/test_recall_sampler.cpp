@@ -0,0 +1,178 @@
+#include "../src/metrics/recall_sampler.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <thread>
+
+using namespace atlas;
+
+// Helper function to compare floats with tolerance
+bool approxEqual(double a, double b, double epsilon = 1e-9) {
+  return std::abs(a - b) < epsilon;
+}
+
+VectorStore makeStore() {
+  VectorStore store(3);
+  store.addVector(1, {1.0f, 0.0f, 0.0f});
+  store.addVector(2, {0.9f, 0.1f, 0.0f});
+  store.addVector(3, {0.0f, 1.0f, 0.0f});
+  store.addVector(4, {0.0f, 0.0f, 1.0f});
+  return store;
+}
+
+void testRecallFromShadowQueries() {
+  std::cout << "Testing rolling recall from shadow queries... ";
+
+  VectorStore store = makeStore();
+  RecallSamplerOptions options;
+  options.sampleRate = 1.0;
+  options.maxCpuFraction = 1.0;
+  RecallSampler sampler(store, options);
+
+  Vector query = {1.0f, 0.0f, 0.0f};
+
+  // Perfect answer, then an answer with one of two neighbors wrong
+  sampler.observe(query, {{1, 0.0f}, {2, 0.01f}}, 2,
+                  std::chrono::microseconds(2000));
+  sampler.observe(query, {{1, 0.0f}, {4, 1.0f}}, 2,
+                  std::chrono::microseconds(4000));
+  sampler.drain();
+
+  RecallMetrics metrics = sampler.metrics();
+  assert(metrics.observed == 2);
+  assert(metrics.sampled == 2);
+  assert(approxEqual(metrics.rollingRecall, 0.75));
+  assert(approxEqual(metrics.rollingLatencyMs, 3.0));
+
+  std::cout << "PASSED" << std::endl;
+}
+
+void testSampleRateZero() {
+  std::cout << "Testing sample rate zero... ";
+
+  VectorStore store = makeStore();
+  RecallSamplerOptions options;
+  options.sampleRate = 0.0;
+  RecallSampler sampler(store, options);
+
+  for (int i = 0; i < 100; i++) {
+    sampler.observe({1.0f, 0.0f, 0.0f}, {{1, 0.0f}}, 1);
+  }
+  sampler.drain();
+
+  RecallMetrics metrics = sampler.metrics();
+  assert(metrics.observed == 100);
+  assert(metrics.sampled == 0);
+
+  std::cout << "PASSED" << std::endl;
+}
+
+void testQueueOverflowDrops() {
+  std::cout << "Testing bounded queue drops samples... ";
+
+  VectorStore store = makeStore();
+  RecallSamplerOptions options;
+  options.sampleRate = 1.0;
+  options.queueCapacity = 1;
+  options.maxCpuFraction = 0.01; // Long rests keep the queue full
+  RecallSampler sampler(store, options);
+
+  for (int i = 0; i < 50; i++) {
+    sampler.observe({1.0f, 0.0f, 0.0f}, {{1, 0.0f}}, 1);
+  }
+
+  RecallMetrics metrics = sampler.metrics();
+  assert(metrics.dropped > 0);
+  assert(metrics.dropped + metrics.sampled <= 50);
+
+  std::cout << "PASSED" << std::endl;
+}
+
+void testInsertsWhileSampling() {
+  std::cout << "Testing inserts while the sampler runs... ";
+
+  const size_t dim = 16;
+  VectorStore store(dim);
+  std::shared_mutex storeMutex;
+  RecallSamplerOptions options;
+  options.sampleRate = 1.0;
+  options.maxCpuFraction = 1.0;
+  options.queueCapacity = 1000;
+  RecallSampler sampler(store, storeMutex, options);
+
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  auto randomVector = [&]() {
+    Vector v(dim);
+    for (auto &x : v) {
+      x = dist(rng);
+    }
+    return v;
+  };
+  std::vector<Vector> queries;
+  for (int i = 0; i < 200; i++) {
+    queries.push_back(randomVector());
+  }
+  std::vector<Vector> rows;
+  for (int i = 0; i < 5000; i++) {
+    rows.push_back(randomVector());
+  }
+
+  // Writer grows the store (reallocating its arena) under the exclusive lock
+  std::thread writer([&]() {
+    for (size_t i = 0; i < rows.size(); i++) {
+      std::unique_lock<std::shared_mutex> lock(storeMutex);
+      store.addVector(i + 1, rows[i]);
+    }
+  });
+  for (const auto &query : queries) {
+    sampler.observe(query, {{1, 0.0f}}, 5);
+    std::this_thread::yield();
+  }
+  writer.join();
+  sampler.drain();
+
+  RecallMetrics metrics = sampler.metrics();
+  assert(store.size() == rows.size());
+  assert(metrics.sampled + metrics.dropped == queries.size());
+  assert(metrics.sampled > 0);
+  assert(metrics.rollingRecall >= 0.0 && metrics.rollingRecall <= 1.0);
+
+  std::cout << "PASSED" << std::endl;
+}
+
+void testInvalidOptions() {
+  std::cout << "Testing option validation... ";
+
+  VectorStore store = makeStore();
+  RecallSamplerOptions options;
+  options.sampleRate = 1.5;
+  bool exceptionThrown = false;
+  try {
+    RecallSampler sampler(store, options);
+  } catch (const std::invalid_argument &e) {
+    exceptionThrown = true;
+  }
+  assert(exceptionThrown);
+
+  std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+  std::cout << "========================================" << std::endl;
+  std::cout << "  RecallSampler Unit Tests" << std::endl;
+  std::cout << "========================================" << std::endl;
+
+  testRecallFromShadowQueries();
+  testSampleRateZero();
+  testQueueOverflowDrops();
+  testInsertsWhileSampling();
+  testInvalidOptions();
+
+  std::cout << "========================================" << std::endl;
+  std::cout << "All tests passed!" << std::endl;
+  std::cout << "========================================" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,226 @@
+#include "index/sharded_index.hpp"
+#include "index/remote_shard.hpp"
+#include "common/vector_store.hpp"
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+// Random rows with IDs 1..count
+void makeRows(size_t count, size_t dim, std::vector<atlas::VectorId>& ids,
+              std::vector<float>& data, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    ids.resize(count);
+    data.resize(count * dim);
+    for (size_t i = 0; i < count; i++) {
+        ids[i] = i + 1;
+    }
+    for (auto& v : data) {
+        v = dist(rng);
+    }
+}
+
+float recallAgainstBruteForce(atlas::ShardedIndex& index, const std::vector<atlas::VectorId>& ids,
+                              const std::vector<float>& data, size_t dim, size_t k) {
+    atlas::VectorStore store(dim);
+    store.addVectors(ids, data);
+    
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    size_t hits = 0;
+    const size_t numQueries = 10;
+    for (size_t q = 0; q < numQueries; q++) {
+        atlas::Vector query(dim);
+        for (auto& v : query) {
+            v = dist(rng);
+        }
+        auto sharded = index.search(query, k, 50);
+        auto exact = store.bruteForceSearch(query, k);
+        assert(sharded.size() == k);
+        for (size_t i = 1; i < sharded.size(); i++) {
+            assert(sharded[i - 1].distance <= sharded[i].distance);
+        }
+        for (const auto& s : sharded) {
+            for (const auto& e : exact) {
+                if (s.id == e.id) {
+                    hits++;
+                    break;
+                }
+            }
+        }
+    }
+    return static_cast<float>(hits) / (numQueries * k);
+}
+
+void testHashPartitionedBuildAndSearch() {
+    std::cout << "Test 1: Hash Partitioned Build And Search... ";
+    
+    const size_t dim = 16;
+    std::vector<atlas::VectorId> ids;
+    std::vector<float> data;
+    makeRows(400, dim, ids, data, 1);
+    
+    atlas::ShardedIndexOptions options;
+    options.numShards = 4;
+    options.M = 8;
+    options.efConstruction = 50;
+    atlas::ShardedIndex index(dim, options);
+    index.build(ids, data);
+    
+    assert(index.size() == 400);
+    float recall = recallAgainstBruteForce(index, ids, data, dim, 5);
+    std::cout << "Recall@5 = " << recall << " ";
+    assert(recall >= 0.8f);
+    
+    std::cout << "PASSED" << std::endl;
+}
+
+void testRangePartitioning() {
+    std::cout << "Test 2: Range Partitioning... ";
+    
+    atlas::ShardedIndexOptions options;
+    options.numShards = 3;
+    options.scheme = atlas::PartitionScheme::Range;
+    options.rangeSplits = {100, 200};
+    atlas::ShardedIndex index(4, options);
+    
+    assert(index.shardFor(0) == 0);
+    assert(index.shardFor(99) == 0);
+    assert(index.shardFor(100) == 1);
+    assert(index.shardFor(199) == 1);
+    assert(index.shardFor(5000) == 2);
+    
+    // Wrong number of split points
+    bool exceptionThrown = false;
+    options.rangeSplits = {100};
+    try {
+        atlas::ShardedIndex bad(4, options);
+    } catch (const std::invalid_argument& e) {
+        exceptionThrown = true;
+    }
+    assert(exceptionThrown);
+    
+    std::cout << "PASSED" << std::endl;
+}
+
+void testRemoteShards() {
+    std::cout << "Test 3: Remote (Unix Socket) Shards... ";
+    
+    const size_t dim = 8;
+    auto dir = std::filesystem::temp_directory_path();
+    std::string path0 = (dir / "atlas_shard0.sock").string();
+    std::string path1 = (dir / "atlas_shard1.sock").string();
+    
+    atlas::ShardServer server0(std::make_unique<atlas::LocalShard>(dim, 8, 50), path0);
+    atlas::ShardServer server1(std::make_unique<atlas::LocalShard>(dim, 8, 50), path1);
+    
+    std::vector<std::unique_ptr<atlas::IndexShard>> shards;
+    shards.push_back(std::make_unique<atlas::RemoteShard>(path0));
+    shards.push_back(std::make_unique<atlas::RemoteShard>(path1));
+    atlas::ShardedIndex index(dim, std::move(shards));
+    
+    std::vector<atlas::VectorId> ids;
+    std::vector<float> data;
+    makeRows(200, dim, ids, data, 2);
+    index.build(ids, data);
+    assert(index.size() == 200);
+    
+    // Exact row of ID 17 comes back first
+    atlas::Vector query(data.begin() + 16 * dim, data.begin() + 17 * dim);
+    auto results = index.search(query, 3, 50);
+    assert(results.size() == 3);
+    assert(results[0].id == 17);
+    
+    // Server-side errors surface as exceptions on the client
+    atlas::RemoteShard direct(path0);
+    bool exceptionThrown = false;
+    try {
+        direct.search(atlas::Vector(dim + 1, 1.0f), 1, 10);
+    } catch (const std::runtime_error& e) {
+        exceptionThrown = true;
+    }
+    assert(exceptionThrown);
+    
+    std::cout << "PASSED" << std::endl;
+}
+
+// Memory mappings of this process (an unjoined thread keeps its stack mapped)
+size_t mappingCount() {
+    std::ifstream maps("/proc/self/maps");
+    std::string line;
+    size_t count = 0;
+    while (std::getline(maps, line)) {
+        count++;
+    }
+    return count;
+}
+
+void testShardServerConnections() {
+    std::cout << "Test 4: Shard Server Connection Handling... ";
+    
+    const size_t dim = 4;
+    std::string path = (std::filesystem::temp_directory_path() / "atlas_shard_conn.sock").string();
+    atlas::ShardServer server(std::make_unique<atlas::LocalShard>(dim, 8, 50), path);
+    
+    // Short-lived connections do not leave threads behind
+    size_t before = mappingCount();
+    for (int i = 0; i < 30; i++) {
+        atlas::RemoteShard shard(path);
+        assert(shard.size() == 0);
+    }
+    atlas::RemoteShard last(path);
+    assert(last.size() == 0);
+    assert(mappingCount() <= before + 10);
+    
+    // A garbage array size drops the connection instead of desynchronizing it
+    atlas::FileDescriptor raw = atlas::connectUnix(path);
+    uint8_t op = 1;  // add
+    uint64_t hugeCount = uint64_t(1) << 60;
+    bool dropped = false;
+    try {
+        // the server may close as soon as it has read the first count
+        atlas::writeAll(raw.get(), &op, sizeof(op));
+        atlas::writeAll(raw.get(), &hugeCount, sizeof(hugeCount));
+        atlas::writeAll(raw.get(), &hugeCount, sizeof(hugeCount));
+        uint8_t status;
+        atlas::readAll(raw.get(), &status, sizeof(status));
+    } catch (const std::runtime_error&) {
+        dropped = true;
+    }
+    assert(dropped);
+    
+    // Other clients are unaffected
+    assert(last.size() == 0);
+    
+    // A zero row rejects the whole batch, which can then be retried without it
+    bool threw = false;
+    try {
+        last.addVectors(std::vector<atlas::VectorId>{1, 2},
+                        std::vector<float>{1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f});
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(last.size() == 0);
+    last.addVectors(std::vector<atlas::VectorId>{1}, std::vector<float>{1.0f, 0.0f, 0.0f, 0.0f});
+    assert(last.size() == 1);
+    auto results = last.search({1.0f, 0.0f, 0.0f, 0.0f}, 1, 10);
+    assert(results.size() == 1 && results[0].id == 1);
+    
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "\n=== Sharded Index Tests ===" << std::endl;
+    
+    testHashPartitionedBuildAndSearch();
+    testRangePartitioning();
+    testRemoteShards();
+    testShardServerConnections();
+    
+    std::cout << "All tests passed!" << std::endl;
+    
+    return 0;
+}
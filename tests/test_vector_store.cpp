@@ -1,5 +1,6 @@
 #include "../src/common/vector_store.hpp"
 #include "../src/distance/distance.hpp"
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
@@ -36,7 +37,7 @@ void testAddSingleVector() {
   assert(store.contains(1));
   assert(!store.contains(2));
 
-  const Vector &retrieved = store.getVector(1);
+  VectorView retrieved = store.getVector(1);
   assert(retrieved.size() == 3);
   assert(approxEqual(retrieved[0], 1.0f));
   assert(approxEqual(retrieved[1], 2.0f));
@@ -159,7 +160,7 @@ void testDuplicateIdHandling() {
   assert(exceptionThrown);
 
   // Original vector should still be there
-  const Vector &vec = store.getVector(1);
+  VectorView vec = store.getVector(1);
   assert(approxEqual(vec[0], 1.0f));
 
   std::cout << "PASSED" << std::endl;
@@ -181,6 +182,125 @@ void testGetNonexistentVector() {
   std::cout << "PASSED" << std::endl;
 }
 
+void testRangeSearch() {
+  std::cout << "Testing range search... ";
+
+  VectorStore store(3);
+  store.addVector(1, {1.0f, 0.0f, 0.0f});
+  store.addVector(2, {0.9f, 0.1f, 0.0f});
+  store.addVector(3, {0.8f, 0.2f, 0.0f});
+  store.addVector(4, {0.0f, 1.0f, 0.0f});
+  store.addVector(5, {0.0f, 0.0f, 1.0f});
+
+  Vector query = {1.0f, 0.0f, 0.0f};
+
+  // Tight radius: only the near-duplicates along the x-axis
+  auto results = store.rangeSearch(query, 0.05f);
+  assert(results.size() == 3);
+  assert(results.id(0) == 1);
+  assert(results.id(1) == 2);
+  assert(results.id(2) == 3);
+  assert(results.distance(0) <= results.distance(1));
+
+  // Nothing within a negative radius
+  assert(store.rangeSearch(query, -1.0f).empty());
+
+  // Everything within the maximum cosine distance
+  assert(store.rangeSearch(query, 2.0f).size() == 5);
+
+  std::cout << "PASSED" << std::endl;
+}
+
+void testBatchAdd() {
+  std::cout << "Testing batch add... ";
+
+  VectorStore store(2);
+  store.addVector(1, {1.0f, 0.0f});
+
+  std::vector<VectorId> ids = {2, 3};
+  std::vector<float> data = {0.0f, 1.0f, 1.0f, 1.0f};
+  store.addVectors(ids, data);
+
+  assert(store.size() == 3);
+  VectorView row = store.getVector(3);
+  assert(approxEqual(row[0], 1.0f));
+  assert(approxEqual(row[1], 1.0f));
+
+  // A batch with a duplicate ID is rejected as a whole
+  bool exceptionThrown = false;
+  std::vector<VectorId> badIds = {4, 1};
+  try {
+    store.addVectors(badIds, data);
+  } catch (const std::invalid_argument &e) {
+    exceptionThrown = true;
+  }
+  assert(exceptionThrown);
+  assert(store.size() == 3);
+  assert(!store.contains(4));
+
+  std::cout << "PASSED" << std::endl;
+}
+
+void testReorder() {
+  std::cout << "Testing reorder... ";
+
+  VectorStore store(2);
+  store.addVector(1, {1.0f, 0.0f});
+  store.addVector(2, {0.0f, 1.0f});
+  store.addVector(3, {1.0f, 1.0f});
+
+  std::vector<VectorId> order = {3, 1, 2};
+  store.reorder(order);
+
+  auto ids = store.ids();
+  assert(ids[0] == 3 && ids[1] == 1 && ids[2] == 2);
+  VectorView row = store.getVector(2);
+  assert(approxEqual(row[0], 0.0f));
+  assert(approxEqual(row[1], 1.0f));
+
+  // Not a permutation: rejected, layout untouched
+  bool exceptionThrown = false;
+  std::vector<VectorId> badOrder = {3, 3, 1};
+  try {
+    store.reorder(badOrder);
+  } catch (const std::invalid_argument &e) {
+    exceptionThrown = true;
+  }
+  assert(exceptionThrown);
+  assert(store.ids()[0] == 3);
+
+  std::cout << "PASSED" << std::endl;
+}
+
+void testMemoryPolicyArena() {
+  std::cout << "Testing huge-page/interleaved arena... ";
+
+  // Large enough that the arena is mmap'ed under the policy
+  const size_t dim = 32;
+  const size_t count = 20000;
+  MemoryPolicy policy{HugePageMode::Transparent, NumaMode::Interleave};
+  VectorStore store(dim, policy);
+  assert(store.getMemoryPolicy() == policy);
+
+  for (size_t i = 0; i < count; i++) {
+    Vector vec(dim, static_cast<float>(i + 1));
+    store.addVector(i, vec);
+  }
+
+  assert(store.size() == count);
+  assert(approxEqual(store.getVector(0)[0], 1.0f));
+  assert(approxEqual(store.getVector(count - 1)[dim - 1],
+                     static_cast<float>(count)));
+
+  // Interleave masks are built from the online node IDs
+  std::vector<int> nodes = onlineNumaNodes();
+  assert(!nodes.empty());
+  assert(std::is_sorted(nodes.begin(), nodes.end()));
+  assert(nodes.size() == numaNodeCount());
+
+  std::cout << "PASSED" << std::endl;
+}
+
 int main() {
   std::cout << "========================================" << std::endl;
   std::cout << "  VectorStore Unit Tests" << std::endl;
@@ -194,6 +314,10 @@ int main() {
   testDimensionValidation();
   testDuplicateIdHandling();
   testGetNonexistentVector();
+  testRangeSearch();
+  testBatchAdd();
+  testReorder();
+  testMemoryPolicyArena();
 
   std::cout << "========================================" << std::endl;
   std::cout << "All tests passed!" << std::endl;
@@ -0,0 +1,391 @@
+#include "net/vector_server.hpp"
+#include "net/vector_client.hpp"
+#include "common/vector_store.hpp"
+#include "index/hnsw.hpp"
+#include <iostream>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <fcntl.h>
+#include <filesystem>
+#include <random>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+// Server with its index running on a background thread
+struct TestServer {
+    atlas::VectorStore store;
+    atlas::HNSW index;
+    atlas::VectorServer server;
+    std::thread loop;
+
+    explicit TestServer(size_t dim) : store(dim), index(store, 16, 100), server(store, index) {}
+
+    void start() {
+        loop = std::thread([this]() { server.run(); });
+    }
+
+    ~TestServer() {
+        server.stop();
+        if (loop.joinable()) {
+            loop.join();
+        }
+    }
+};
+
+std::string socketPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Random rows with IDs 1..count
+void makeRows(size_t count, size_t dim, std::vector<atlas::VectorId>& ids,
+              std::vector<float>& data, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    ids.resize(count);
+    data.resize(count * dim);
+    for (size_t i = 0; i < count; i++) {
+        ids[i] = i + 1;
+    }
+    for (auto& v : data) {
+        v = dist(rng);
+    }
+}
+
+void testFrameRoundTrip() {
+    std::cout << "Test 1: Frame Round Trip... ";
+
+    std::vector<char> buffer;
+    std::vector<float> floats = {1.5f, -2.0f, 3.25f};
+    atlas::wire::FrameWriter writer(buffer, atlas::wire::Op::Search, 7);
+    writer.put<uint32_t>(42);
+    writer.putArray<float>(floats);
+    writer.finish();
+    assert(buffer.size() == atlas::wire::kHeaderSize + 4 + 12);
+
+    auto header = atlas::wire::decodeHeader(buffer.data());
+    assert(header.length == 16);
+    assert(header.requestId == 7);
+    assert(header.op == atlas::wire::Op::Search);
+    assert(header.status == atlas::wire::Status::Ok);
+
+    atlas::wire::FrameReader reader(std::span<const char>(
+        buffer.data() + atlas::wire::kHeaderSize, header.length));
+    assert(reader.get<uint32_t>() == 42);
+    std::vector<float> decoded;
+    reader.getArray<float>(3, decoded);
+    assert(decoded == floats);
+    assert(reader.remaining() == 0);
+
+    // Reading past the payload is a malformed request
+    bool threw = false;
+    try {
+        reader.get<uint32_t>();
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "PASSED" << std::endl;
+}
+
+void testInsertAndSearchOverUnixSocket() {
+    std::cout << "Test 2: Insert And Search Over Unix Socket... ";
+
+    const size_t dim = 16;
+    std::string path = socketPath("atlas_wire_test.sock");
+    TestServer server(dim);
+    server.server.listenUnix(path);
+    server.start();
+
+    auto client = atlas::VectorClient::connectUnix(path);
+    std::vector<atlas::VectorId> ids;
+    std::vector<float> data;
+    makeRows(300, dim, ids, data, 1);
+    client.insert(ids, data);
+    assert(client.size() == 300);
+
+    // Searching a stored vector finds it first, with the server's own distances
+    atlas::Vector query(data.begin() + 41 * dim, data.begin() + 42 * dim);
+    auto results = client.search(query, 5, 50);
+    assert(results.size() == 5);
+    assert(results[0].id == 42);
+    auto direct = server.index.search(query, 5, 50);
+    for (size_t i = 0; i < results.size(); i++) {
+        assert(results[i].id == direct[i].id);
+        assert(results[i].distance == direct[i].distance);
+    }
+
+    // Batch search: one result list per query row
+    std::vector<float> batch(data.begin(), data.begin() + 3 * dim);
+    auto lists = client.searchBatch(batch, dim, 4, 50);
+    assert(lists.size() == 3);
+    for (size_t q = 0; q < 3; q++) {
+        assert(lists[q].size() == 4);
+        assert(lists[q][0].id == q + 1);
+    }
+
+    std::cout << "PASSED" << std::endl;
+}
+
+void testPipeliningOverTcp() {
+    std::cout << "Test 3: Pipelined Requests Over TCP... ";
+
+    const size_t dim = 8;
+    TestServer server(dim);
+    uint16_t port = server.server.listenTcp(0);
+    server.start();
+
+    auto client = atlas::VectorClient::connectTcp("127.0.0.1", port);
+    std::vector<atlas::VectorId> ids;
+    std::vector<float> data;
+    makeRows(100, dim, ids, data, 2);
+
+    // Insert, then many searches, all sent before any answer is read
+    uint32_t insertId = client.sendInsert(ids, data);
+    std::vector<uint32_t> searchIds;
+    for (size_t i = 0; i < 20; i++) {
+        std::span<const float> row(data.data() + i * dim, dim);
+        searchIds.push_back(client.sendSearch(row, dim, 1, 32));
+    }
+
+    client.receiveInsert(insertId);
+    for (size_t i = 0; i < searchIds.size(); i++) {
+        auto lists = client.receiveSearch(searchIds[i]);
+        assert(lists.size() == 1 && lists[0].size() == 1);
+        assert(lists[0][0].id == ids[i]);
+    }
+
+    std::cout << "PASSED" << std::endl;
+}
+
+void testServerErrors() {
+    std::cout << "Test 4: Server-Side Errors Keep The Connection... ";
+
+    const size_t dim = 4;
+    std::string path = socketPath("atlas_wire_errors.sock");
+    TestServer server(dim);
+    server.server.listenUnix(path);
+    server.start();
+
+    auto client = atlas::VectorClient::connectUnix(path);
+    client.insert(std::vector<atlas::VectorId>{1}, std::vector<float>{1.0f, 0.0f, 0.0f, 0.0f});
+
+    // Wrong dimension
+    bool threw = false;
+    try {
+        client.search({1.0f, 0.0f}, 1);
+    } catch (const std::runtime_error& e) {
+        threw = true;
+        assert(std::string(e.what()).find("dimension") != std::string::npos);
+    }
+    assert(threw);
+
+    // Duplicate ID: the whole batch is rejected
+    threw = false;
+    try {
+        client.insert(std::vector<atlas::VectorId>{2, 1},
+                      std::vector<float>{0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f});
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Connection is still usable
+    assert(client.size() == 1);
+    auto results = client.search({1.0f, 0.0f, 0.0f, 0.0f}, 1);
+    assert(results.size() == 1 && results[0].id == 1);
+
+    std::cout << "PASSED" << std::endl;
+}
+
+void testZeroVectorInsert() {
+    std::cout << "Test 5: Zero Vector Insert Is Rejected Whole... ";
+
+    const size_t dim = 4;
+    std::string path = socketPath("atlas_wire_zero.sock");
+    TestServer server(dim);
+    server.server.listenUnix(path);
+    server.start();
+
+    auto client = atlas::VectorClient::connectUnix(path);
+
+    // A zero vector into the empty index must not become its entry point
+    bool threw = false;
+    try {
+        client.insert(std::vector<atlas::VectorId>{1}, std::vector<float>(dim, 0.0f));
+    } catch (const std::runtime_error& e) {
+        threw = true;
+        assert(std::string(e.what()).find("zero magnitude") != std::string::npos);
+    }
+    assert(threw);
+    assert(client.size() == 0);
+
+    client.insert(std::vector<atlas::VectorId>{1}, std::vector<float>{1.0f, 0.0f, 0.0f, 0.0f});
+
+    // A batch with one zero row stores none of its rows
+    threw = false;
+    try {
+        client.insert(std::vector<atlas::VectorId>{2, 3},
+                      std::vector<float>{0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f});
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(client.size() == 1);
+
+    // Searches still work and the valid part of the batch can be retried
+    auto results = client.search({1.0f, 0.1f, 0.0f, 0.0f}, 1);
+    assert(results.size() == 1 && results[0].id == 1);
+    client.insert(std::vector<atlas::VectorId>{2}, std::vector<float>{0.0f, 1.0f, 0.0f, 0.0f});
+    assert(client.size() == 2);
+    results = client.search({0.1f, 1.0f, 0.0f, 0.0f}, 1);
+    assert(results.size() == 1 && results[0].id == 2);
+
+    std::cout << "PASSED" << std::endl;
+}
+
+void testBackpressure() {
+    std::cout << "Test 6: Backpressure On A Client That Does Not Read... ";
+
+    const size_t dim = 4;
+    const uint32_t k = 100;
+    std::string path = socketPath("atlas_wire_backpressure.sock");
+    TestServer server(dim);
+    server.server.listenUnix(path);
+    server.start();
+
+    std::vector<atlas::VectorId> ids;
+    std::vector<float> data;
+    makeRows(200, dim, ids, data, 3);
+    atlas::VectorClient::connectUnix(path).insert(ids, data);
+
+    // ~50 request bytes produce ~1.2 KB of response each
+    std::vector<char> frame;
+    atlas::wire::FrameWriter writer(frame, atlas::wire::Op::Search, 0);
+    writer.put<uint32_t>(k);
+    writer.put<uint32_t>(k);
+    writer.put<uint32_t>(static_cast<uint32_t>(dim));
+    writer.put<uint32_t>(1);
+    writer.putArray<float>(std::span<const float>(data.data(), dim));
+    writer.finish();
+
+    // Pipeline without reading until the server stops taking requests
+    // (no progress for 2 s; a busy server that still reads catches up sooner)
+    atlas::FileDescriptor conn = atlas::connectUnix(path);
+    atlas::setNonBlocking(conn.get());
+    const size_t maxBytes = 2u << 20;
+    size_t sent = 0;
+    int stalls = 0;
+    while (sent < maxBytes && stalls < 100) {
+        size_t offset = sent % frame.size();
+        ssize_t n = ::write(conn.get(), frame.data() + offset, frame.size() - offset);
+        if (n > 0) {
+            sent += static_cast<size_t>(n);
+            stalls = 0;
+        } else {
+            assert(errno == EAGAIN || errno == EWOULDBLOCK);
+            stalls++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+    // Without backpressure the server would take it all (~25x that in responses)
+    assert(sent < maxBytes && "server kept reading while its output was stuck");
+
+    // Once the client reads, the held-back requests are answered in order
+    ::fcntl(conn.get(), F_SETFL, ::fcntl(conn.get(), F_GETFL) & ~O_NONBLOCK);
+    size_t partial = sent % frame.size();
+    if (partial != 0) {
+        atlas::writeAll(conn.get(), frame.data() + partial, frame.size() - partial);
+        sent += frame.size() - partial;
+    }
+    size_t frames = sent / frame.size();
+    std::vector<char> payload;
+    for (size_t i = 0; i < frames; i++) {
+        char header[atlas::wire::kHeaderSize];
+        atlas::readAll(conn.get(), header, sizeof(header));
+        auto decoded = atlas::wire::decodeHeader(header);
+        assert(decoded.status == atlas::wire::Status::Ok);
+        payload.resize(decoded.length);
+        atlas::readAll(conn.get(), payload.data(), payload.size());
+        assert(payload.size() == 4 + k * atlas::wire::kResultSize);
+    }
+
+    auto client = atlas::VectorClient::connectUnix(path);
+    assert(client.size() == 200);
+
+    std::cout << "PASSED" << std::endl;
+}
+
+void testHalfClose() {
+    std::cout << "Test 7: Half-Closed Client Still Gets Every Answer... ";
+
+    const size_t dim = 8;
+    const uint32_t k = 100;
+    const size_t batches = 200;
+    const size_t perBatch = 20;
+    std::string path = socketPath("atlas_wire_half_close.sock");
+    TestServer server(dim);
+    server.server.listenUnix(path);
+    server.start();
+
+    std::vector<atlas::VectorId> ids;
+    std::vector<float> data;
+    makeRows(300, dim, ids, data, 4);
+    atlas::VectorClient::connectUnix(path).insert(ids, data);
+
+    // Pipelined batch searches (~4.8 MB of answers, over the backpressure
+    // limit), then shutdown(SHUT_WR) before reading anything
+    std::vector<char> frames;
+    for (size_t b = 0; b < batches; b++) {
+        atlas::wire::FrameWriter writer(frames, atlas::wire::Op::Search,
+                                        static_cast<uint32_t>(b));
+        writer.put<uint32_t>(k);
+        writer.put<uint32_t>(k);
+        writer.put<uint32_t>(static_cast<uint32_t>(dim));
+        writer.put<uint32_t>(static_cast<uint32_t>(perBatch));
+        writer.putArray<float>(std::span<const float>(data.data(), perBatch * dim));
+        writer.finish();
+    }
+    atlas::FileDescriptor conn = atlas::connectUnix(path);
+    std::thread sender([&]() {
+        atlas::writeAll(conn.get(), frames.data(), frames.size());
+        ::shutdown(conn.get(), SHUT_WR);
+    });
+
+    std::vector<char> payload;
+    for (size_t b = 0; b < batches; b++) {
+        char header[atlas::wire::kHeaderSize];
+        atlas::readAll(conn.get(), header, sizeof(header));
+        auto decoded = atlas::wire::decodeHeader(header);
+        assert(decoded.requestId == b);
+        assert(decoded.status == atlas::wire::Status::Ok);
+        payload.resize(decoded.length);
+        atlas::readAll(conn.get(), payload.data(), payload.size());
+        assert(payload.size() == perBatch * (4 + k * atlas::wire::kResultSize));
+    }
+    sender.join();
+
+    // Then the server closes its side
+    char extra;
+    assert(::read(conn.get(), &extra, 1) == 0);
+
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "\n=== Wire Protocol Tests ===" << std::endl;
+
+    testFrameRoundTrip();
+    testInsertAndSearchOverUnixSocket();
+    testPipeliningOverTcp();
+    testServerErrors();
+    testZeroVectorInsert();
+    testBackpressure();
+    testHalfClose();
+
+    std::cout << "All tests passed!" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "common/binary_store.hpp"
+#include "common/vector_store.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/**
+ * Binary quantization benchmark
+ *
+ * Compares exact VectorStore::bruteForceSearch against the BinaryStore
+ * Hamming pre-filter + fp32 re-rank at several over-fetch factors,
+ * reporting QPS and recall@k.
+ *
+ * Usage: bench_binary [numVectors=20000] [dim=1536] [queries=50] [k=10]
+ */
+
+using namespace atlas;
+
+int main(int argc, char* argv[]) {
+    size_t numVectors = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    size_t dim = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1536;
+    size_t numQueries = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 50;
+    size_t k = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 10;
+
+    std::mt19937 rng(42);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+
+    VectorStore store(dim);
+    store.reserve(numVectors);
+    Vector vec(dim);
+    for (size_t i = 0; i < numVectors; i++) {
+        for (auto& v : vec) {
+            v = dist(rng);
+        }
+        store.addVector(i, vec);
+    }
+    BinaryStore codes(store);
+
+    // queries are perturbed copies of stored vectors
+    std::vector<Vector> queries;
+    for (size_t q = 0; q < numQueries; q++) {
+        VectorView base = store.getVector((q * 7919) % numVectors);
+        Vector query(base.begin(), base.end());
+        for (auto& v : query) {
+            v += 0.5f * dist(rng);
+        }
+        queries.push_back(std::move(query));
+    }
+
+    std::cout << "numVectors=" << numVectors << " dim=" << dim
+              << " fp32=" << numVectors * dim * sizeof(float) / (1 << 20) << "MB"
+              << " codes=" << codes.codeBytes() / (1 << 20) << "MB" << std::endl;
+
+    std::vector<std::vector<VectorWithDistance>> exact;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& query : queries) {
+        exact.push_back(store.bruteForceSearch(query, k));
+    }
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    std::cout << "bruteForce: " << numQueries / seconds << " QPS recall=1" << std::endl;
+
+    for (size_t overFetch : {1, 2, 4, 8, 16}) {
+        size_t hits = 0;
+        start = std::chrono::steady_clock::now();
+        for (size_t q = 0; q < numQueries; q++) {
+            auto approx = codes.search(queries[q], k, overFetch);
+            for (const auto& a : approx) {
+                for (const auto& e : exact[q]) {
+                    if (a.id == e.id) {
+                        hits++;
+                        break;
+                    }
+                }
+            }
+        }
+        seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        std::cout << "binary overFetch=" << overFetch << ": " << numQueries / seconds
+                  << " QPS recall=" << static_cast<double>(hits) / (numQueries * k)
+                  << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "distance/distance.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/**
+ * Fixed-dimension kernel benchmark
+ *
+ * For each common embedding dimension, times the generic cosine distance
+ * against the kernel selectCosineDistance() picks for that dimension over
+ * a cache-resident set of rows.
+ *
+ * Usage: bench_distance [iterations=2000000]
+ */
+
+using namespace atlas;
+
+double nsPerCall(CosineDistanceFn kernel, const std::vector<float>& rows,
+                 const std::vector<float>& query, size_t dim, size_t iterations) {
+    const size_t numRows = rows.size() / dim;
+    volatile float sink = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        sink = sink + kernel(query.data(), rows.data() + (i % numRows) * dim, dim);
+    }
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / iterations;
+}
+
+int main(int argc, char* argv[]) {
+    size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    for (size_t dim : {128, 384, 768, 1536}) {
+        // 64 rows stay in L1/L2 so we time the kernel, not memory
+        std::vector<float> rows(64 * dim);
+        std::vector<float> query(dim);
+        for (auto& v : rows) {
+            v = dist(rng);
+        }
+        for (auto& v : query) {
+            v = dist(rng);
+        }
+
+        size_t iters = iterations * 128 / dim;
+        double generic = nsPerCall(cosineDistanceGeneric, rows, query, dim, iters);
+        double fixed = nsPerCall(selectCosineDistance(dim), rows, query, dim, iters);
+
+        std::cout << "dim=" << dim
+                  << " generic=" << generic << "ns"
+                  << " fixed=" << fixed << "ns"
+                  << " speedup=" << generic / fixed << "x" << std::endl;
+    }
+
+    return 0;
+}
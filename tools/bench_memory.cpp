@@ -0,0 +1,106 @@
+#include "common/memory.hpp"
+#include "common/vector_store.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Memory placement benchmark
+ *
+ * Fills a VectorStore under each MemoryPolicy and measures brute-force
+ * query throughput with search threads pinned round-robin to NUMA nodes.
+ * Brute force streams the whole arena per query, so it is the workload
+ * most sensitive to remote-memory latency and TLB reach.
+ *
+ * Usage: bench_memory [numVectors=500000] [dim=128] [threads=hw] [queriesPerThread=20]
+ */
+
+using namespace atlas;
+
+struct Config {
+    std::string name;
+    MemoryPolicy policy;
+};
+
+double runConfig(const Config& config, size_t numVectors, size_t dim,
+                 size_t threads, size_t queriesPerThread) {
+    VectorStore store(dim, config.policy);
+    store.reserve(numVectors);
+
+    // Fill in chunks from one thread, like a single-threaded loader would
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    const size_t chunk = 4096;
+    std::vector<VectorId> ids;
+    std::vector<float> data;
+    for (size_t begin = 0; begin < numVectors; begin += chunk) {
+        size_t count = std::min(chunk, numVectors - begin);
+        ids.resize(count);
+        data.resize(count * dim);
+        for (size_t i = 0; i < count; i++) {
+            ids[i] = begin + i;
+        }
+        for (auto& v : data) {
+            v = dist(rng);
+        }
+        store.addVectors(ids, data);
+    }
+
+    std::vector<int> nodes = onlineNumaNodes();
+    std::atomic<size_t> completed{0};
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            pinCurrentThreadToNode(nodes[t % nodes.size()]);
+            std::mt19937 qrng(1000 + t);
+            Vector query(dim);
+            for (size_t q = 0; q < queriesPerThread; q++) {
+                for (auto& v : query) {
+                    v = dist(qrng);
+                }
+                store.bruteForceSearch(query, 10);
+                completed++;
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    return completed.load() / seconds;
+}
+
+int main(int argc, char* argv[]) {
+    size_t numVectors = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500000;
+    size_t dim = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 128;
+    size_t threads = argc > 3 ? std::strtoull(argv[3], nullptr, 10)
+                              : std::max(1u, std::thread::hardware_concurrency());
+    size_t queriesPerThread = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 20;
+
+    std::cout << "numVectors=" << numVectors << " dim=" << dim
+              << " threads=" << threads << " numaNodes=" << numaNodeCount() << std::endl;
+
+    std::vector<Config> configs = {
+        {"default", {HugePageMode::None, NumaMode::Local}},
+        {"thp", {HugePageMode::Transparent, NumaMode::Local}},
+        {"hugetlb", {HugePageMode::Explicit, NumaMode::Local}},
+        {"interleave", {HugePageMode::None, NumaMode::Interleave}},
+        {"thp+interleave", {HugePageMode::Transparent, NumaMode::Interleave}},
+    };
+
+    for (const auto& config : configs) {
+        double qps = runConfig(config, numVectors, dim, threads, queriesPerThread);
+        std::cout << config.name << ": " << qps << " QPS" << std::endl;
+    }
+
+    return 0;
+}
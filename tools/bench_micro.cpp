@@ -0,0 +1,412 @@
+#include "distance/distance.hpp"
+#include "common/vector_store.hpp"
+#include "index/hnsw.hpp"
+#include "common/thread_pool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <linux/perf_event.h>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * Distance-kernel and traversal microbenchmark
+ *
+ * Times dotProduct, cosineSimilarity, the cosine-distance kernel that
+ * VectorStore selects for the dimension (selectCosineDistance) and
+ * normalize per call over a cache-resident row set (64 rows, read in
+ * order) and a DRAM-resident one (--dram-mb of rows, read in a shuffled
+ * order so neither the caches nor the prefetcher hide the misses), for
+ * each common embedding dimension.
+ * Times HNSW search (descent plus the layer-0 searchLayer expansion that
+ * dominates it) per query for small and large graphs: as built, seeded
+ * from precomputed entry points, and after reorderForLocality().
+ * Compares HNSW::merge of 2..16 prebuilt partition graphs with inserting
+ * every vector into one graph; both run on one thread, so the rows
+ * compare work (merge runs on the pool and divides by its size).
+ *
+ * Cycles, instructions, LLC misses and dTLB misses are read with
+ * perf_event_open (user space only) and reported per operation; counters
+ * the kernel refuses (perf_event_paranoid, containers, VMs) are null.
+ * Results are written to stdout as one JSON document so runs before and
+ * after a change can be diffed.
+ *
+ * Usage: bench_micro [--quick] [--dram-mb N] [--min-ms N]
+ */
+
+using namespace atlas;
+
+namespace {
+
+// One perf counter per event (not a group, so a missing event only
+// disables itself)
+class PerfCounters {
+public:
+    enum Event { kCycles, kInstructions, kLlcMisses, kDtlbMisses, kNumEvents };
+
+    PerfCounters() {
+        const uint64_t cacheMiss = (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        const std::pair<uint32_t, uint64_t> events[kNumEvents] = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | cacheMiss},
+            {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | cacheMiss},
+        };
+        for (int e = 0; e < kNumEvents; e++) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = events[e].first;
+            attr.config = events[e].second;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fds_[e] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+    }
+
+    ~PerfCounters() {
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available(Event e) const { return fds_[e] >= 0; }
+
+    bool anyAvailable() const {
+        for (int e = 0; e < kNumEvents; e++) {
+            if (available(static_cast<Event>(e))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void start() {
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    void stop() {
+        for (int e = 0; e < kNumEvents; e++) {
+            values_[e] = 0;
+            if (fds_[e] >= 0) {
+                ioctl(fds_[e], PERF_EVENT_IOC_DISABLE, 0);
+                if (read(fds_[e], &values_[e], sizeof(uint64_t)) != sizeof(uint64_t)) {
+                    values_[e] = 0;
+                }
+            }
+        }
+    }
+
+    uint64_t value(Event e) const { return values_[e]; }
+
+private:
+    int fds_[kNumEvents];
+    uint64_t values_[kNumEvents] = {};
+};
+
+struct Measurement {
+    size_t ops = 0;
+    double seconds = 0.0;
+    uint64_t counters[PerfCounters::kNumEvents] = {};
+};
+
+// Run body(ops) with ops doubling until it takes minMs, then measure one
+// more run of that size under the counters
+template <typename Body>
+Measurement measure(PerfCounters& perf, double minMs, Body body) {
+    size_t ops = 1;
+    while (true) {
+        auto start = std::chrono::steady_clock::now();
+        body(ops);
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        if (ms >= minMs) {
+            break;
+        }
+        ops *= 2;
+    }
+
+    Measurement m;
+    m.ops = ops;
+    perf.start();
+    auto start = std::chrono::steady_clock::now();
+    body(ops);
+    m.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    perf.stop();
+    for (int e = 0; e < PerfCounters::kNumEvents; e++) {
+        m.counters[e] = perf.value(static_cast<PerfCounters::Event>(e));
+    }
+    return m;
+}
+
+// Emits the benchmark array; one object per measurement
+class JsonReport {
+public:
+    explicit JsonReport(const PerfCounters& perf) : perf_(perf) {}
+
+    void add(const std::string& name, size_t dim, size_t rows, const char* resident,
+             const Measurement& m) {
+        std::printf("%s    {\"name\": \"%s\", \"dim\": %zu, \"rows\": %zu, \"resident\": \"%s\", "
+                    "\"ops\": %zu, \"ns_per_op\": %.3f",
+                    first_ ? "" : ",\n", name.c_str(), dim, rows, resident, m.ops,
+                    m.seconds * 1e9 / m.ops);
+        field("cycles_per_op", PerfCounters::kCycles, m);
+        field("instructions_per_op", PerfCounters::kInstructions, m);
+        field("llc_misses_per_op", PerfCounters::kLlcMisses, m);
+        field("dtlb_misses_per_op", PerfCounters::kDtlbMisses, m);
+        if (perf_.available(PerfCounters::kCycles) &&
+            perf_.available(PerfCounters::kInstructions) && m.counters[PerfCounters::kCycles]) {
+            std::printf(", \"ipc\": %.3f",
+                        static_cast<double>(m.counters[PerfCounters::kInstructions]) /
+                            m.counters[PerfCounters::kCycles]);
+        } else {
+            std::printf(", \"ipc\": null");
+        }
+        std::printf("}");
+        std::fflush(stdout);
+        first_ = false;
+    }
+
+private:
+    void field(const char* key, PerfCounters::Event e, const Measurement& m) {
+        if (perf_.available(e)) {
+            std::printf(", \"%s\": %.4f", key, static_cast<double>(m.counters[e]) / m.ops);
+        } else {
+            std::printf(", \"%s\": null", key);
+        }
+    }
+
+    const PerfCounters& perf_;
+    bool first_ = true;
+};
+
+std::vector<float> randomRows(size_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> rows(count);
+    for (auto& v : rows) {
+        v = dist(rng);
+    }
+    return rows;
+}
+
+void benchKernels(JsonReport& report, PerfCounters& perf, size_t dim, size_t numRows,
+                  const char* resident, double minMs, std::mt19937& rng) {
+    std::vector<float> rows = randomRows(numRows * dim, rng);
+    std::vector<float> query = randomRows(dim, rng);
+
+    // cache-resident rows are read in order, DRAM-resident ones shuffled
+    std::vector<uint32_t> order(numRows);
+    std::iota(order.begin(), order.end(), 0);
+    if (numRows > 64) {
+        std::shuffle(order.begin(), order.end(), rng);
+    }
+
+    auto row = [&](size_t i) {
+        return std::span<float>(rows.data() + size_t(order[i % numRows]) * dim, dim);
+    };
+
+    volatile float sink = 0.0f;
+    report.add("dotProduct", dim, numRows, resident, measure(perf, minMs, [&](size_t ops) {
+        float acc = 0.0f;
+        for (size_t i = 0; i < ops; i++) {
+            acc += dotProduct(query, row(i));
+        }
+        sink = sink + acc;
+    }));
+    report.add("cosineSimilarity", dim, numRows, resident, measure(perf, minMs, [&](size_t ops) {
+        float acc = 0.0f;
+        for (size_t i = 0; i < ops; i++) {
+            acc += cosineSimilarity(query, row(i));
+        }
+        sink = sink + acc;
+    }));
+    // the kernel VectorStore::cosineDistance uses on the search path
+    // (fixed-dimension specializations for 128/384/768/1536)
+    CosineDistanceFn selected = selectCosineDistance(dim);
+    report.add("cosineDistanceSelected", dim, numRows, resident,
+               measure(perf, minMs, [&](size_t ops) {
+                   float acc = 0.0f;
+                   for (size_t i = 0; i < ops; i++) {
+                       acc += selected(query.data(), row(i).data(), dim);
+                   }
+                   sink = sink + acc;
+               }));
+    // rows are unit length after the first pass, so later passes do the same work
+    report.add("normalize", dim, numRows, resident, measure(perf, minMs, [&](size_t ops) {
+        for (size_t i = 0; i < ops; i++) {
+            normalize(row(i));
+        }
+    }));
+}
+
+void benchSearch(JsonReport& report, PerfCounters& perf, size_t dim, size_t numVectors,
+                 double minMs, std::mt19937& rng) {
+    VectorStore store(dim);
+    std::vector<float> data = randomRows(numVectors * dim, rng);
+    std::vector<VectorId> ids(numVectors);
+    std::iota(ids.begin(), ids.end(), 1);
+    store.addVectors(ids, data);
+
+    HNSW hnsw(store, 16, 100);
+    for (VectorId id : ids) {
+        hnsw.addVector(id);
+    }
+
+    const size_t numQueries = 256;
+    std::vector<Vector> queries;
+    for (size_t q = 0; q < numQueries; q++) {
+        std::vector<float> query = randomRows(dim, rng);
+        queries.emplace_back(query.begin(), query.end());
+    }
+
+    // graph plus vectors: a few MB is cache-resident, beyond the LLC it is not
+    size_t bytes = numVectors * dim * sizeof(float);
+    const char* resident = bytes <= (4u << 20) ? "cache" : "dram";
+
+    volatile size_t sink = 0;
+    report.add("hnswSearch_ef64_k10", dim, numVectors, resident,
+               measure(perf, minMs, [&](size_t ops) {
+                   for (size_t i = 0; i < ops; i++) {
+                       sink = sink + hnsw.search(queries[i % numQueries], 10, 64).size();
+                   }
+               }));
+
+    // same queries seeded from k-means entry points instead of the descent
+    hnsw.buildEntryPoints(32);
+    report.add("hnswSearch_ef64_k10_seeded32", dim, numVectors, resident,
+               measure(perf, minMs, [&](size_t ops) {
+                   for (size_t i = 0; i < ops; i++) {
+                       sink = sink + hnsw.search(queries[i % numQueries], 10, 64).size();
+                   }
+               }));
+    hnsw.clearEntryPoints();
+
+    // same queries after the locality pass (compare llc/dtlb misses per op
+    // with the first row: vectors and adjacency lists are now in BFS order)
+    hnsw.reorderForLocality();
+    report.add("hnswSearch_ef64_k10_reordered", dim, numVectors, resident,
+               measure(perf, minMs, [&](size_t ops) {
+                   for (size_t i = 0; i < ops; i++) {
+                       sink = sink + hnsw.search(queries[i % numQueries], 10, 64).size();
+                   }
+               }));
+}
+
+void benchMerge(JsonReport& report, PerfCounters& perf, size_t dim, size_t numVectors,
+                double minMs, std::mt19937& rng) {
+    VectorStore store(dim);
+    std::vector<float> data = randomRows(numVectors * dim, rng);
+    std::vector<VectorId> ids(numVectors);
+    std::iota(ids.begin(), ids.end(), 1);
+    store.addVectors(ids, data);
+
+    size_t bytes = numVectors * dim * sizeof(float);
+    const char* resident = bytes <= (4u << 20) ? "cache" : "dram";
+
+    volatile size_t sink = 0;
+    report.add("hnswBuild_M16_ef100", dim, numVectors, resident,
+               measure(perf, minMs, [&](size_t ops) {
+                   for (size_t i = 0; i < ops; i++) {
+                       HNSW full(store, 16, 100);
+                       for (VectorId id : ids) {
+                           full.addVector(id);
+                       }
+                       sink = sink + full.localityOrder().size();
+                   }
+               }));
+
+    // merge only (the partitions are built beforehand, untimed)
+    ThreadPool pool(1);
+    for (size_t numParts : {2, 4, 8, 16}) {
+        std::vector<std::unique_ptr<HNSW>> parts;
+        std::vector<const HNSW*> partPtrs;
+        for (size_t p = 0; p < numParts; p++) {
+            parts.push_back(std::make_unique<HNSW>(store, 16, 100));
+            partPtrs.push_back(parts.back().get());
+        }
+        for (size_t i = 0; i < ids.size(); i++) {
+            parts[i % numParts]->addVector(ids[i]);
+        }
+        report.add("hnswMerge_P" + std::to_string(numParts) + "_ef32", dim, numVectors,
+                   resident, measure(perf, minMs, [&](size_t ops) {
+                       for (size_t i = 0; i < ops; i++) {
+                           HNSW merged(store, 16, 100);
+                           merged.merge(partPtrs, pool, 32);
+                           sink = sink + merged.localityOrder().size();
+                       }
+                   }));
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool quick = false;
+    size_t dramMb = 512;
+    double minMs = 100.0;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--quick") {
+            quick = true;
+        } else if (arg == "--dram-mb" && i + 1 < argc) {
+            dramMb = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--min-ms" && i + 1 < argc) {
+            minMs = std::strtod(argv[++i], nullptr);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--quick] [--dram-mb N] [--min-ms N]"
+                      << std::endl;
+            return 1;
+        }
+    }
+    if (quick) {
+        dramMb = std::min<size_t>(dramMb, 64);
+        minMs = std::min(minMs, 20.0);
+    }
+
+    std::mt19937 rng(42);
+    PerfCounters perf;
+
+    std::printf("{\n  \"perf_counters\": %s,\n  \"benchmarks\": [\n",
+                perf.anyAvailable() ? "true" : "false");
+    JsonReport report(perf);
+
+    for (size_t dim : {128, 384, 768, 1536}) {
+        benchKernels(report, perf, dim, 64, "cache", minMs, rng);
+        size_t dramRows = std::max<size_t>(dramMb * (1u << 20) / (dim * sizeof(float)), 64);
+        benchKernels(report, perf, dim, dramRows, "dram", minMs, rng);
+    }
+
+    std::vector<size_t> graphSizes = quick ? std::vector<size_t>{1000, 5000}
+                                           : std::vector<size_t>{2000, 50000};
+    for (size_t dim : {128, 768}) {
+        for (size_t numVectors : graphSizes) {
+            benchSearch(report, perf, dim, numVectors, minMs, rng);
+        }
+    }
+
+    benchMerge(report, perf, 128, quick ? 5000 : 20000, minMs, rng);
+
+    std::printf("\n  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include "common/vector_store.hpp"
+#include "index/hnsw.hpp"
+#include "net/vector_client.hpp"
+#include "net/vector_server.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Wire protocol latency benchmark
+ *
+ * Starts a VectorServer in-process on a Unix domain socket (or TCP
+ * loopback with --tcp), loads random vectors through Insert frames, then
+ * compares per-query latency of a direct HNSW::search call against a
+ * client round trip, and measures pipelined and batched throughput.
+ *
+ * Usage: bench_wire [numVectors=10000] [dim=768] [queries=1000] [--tcp]
+ */
+
+using namespace atlas;
+
+using Clock = std::chrono::steady_clock;
+
+void report(const std::string& name, std::vector<double>& micros) {
+    std::sort(micros.begin(), micros.end());
+    double sum = 0.0;
+    for (double m : micros) {
+        sum += m;
+    }
+    std::cout << name << ": mean=" << sum / micros.size() << "us"
+              << " p50=" << micros[micros.size() / 2] << "us"
+              << " p99=" << micros[micros.size() * 99 / 100] << "us" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> positional;
+    bool useTcp = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--tcp") == 0) {
+            useTcp = true;
+        } else {
+            positional.push_back(argv[i]);
+        }
+    }
+    size_t numVectors = positional.size() > 0 ? std::strtoull(positional[0].c_str(), nullptr, 10) : 10000;
+    size_t dim = positional.size() > 1 ? std::strtoull(positional[1].c_str(), nullptr, 10) : 768;
+    size_t numQueries = positional.size() > 2 ? std::strtoull(positional[2].c_str(), nullptr, 10) : 1000;
+    const size_t k = 10;
+    const size_t efSearch = 64;
+
+    VectorStore store(dim);
+    HNSW index(store, 16, 100);
+    VectorServer server(store, index);
+    std::string path = (std::filesystem::temp_directory_path() / "atlas_bench_wire.sock").string();
+    uint16_t port = 0;
+    if (useTcp) {
+        port = server.listenTcp(0);
+    } else {
+        server.listenUnix(path);
+    }
+    std::thread loop([&server]() { server.run(); });
+
+    {
+        VectorClient client = useTcp ? VectorClient::connectTcp("127.0.0.1", port)
+                                     : VectorClient::connectUnix(path);
+
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+        // load through the protocol in batches
+        const size_t batch = 1000;
+        std::vector<VectorId> ids;
+        std::vector<float> data;
+        auto loadStart = Clock::now();
+        for (size_t start = 0; start < numVectors; start += batch) {
+            size_t count = std::min(batch, numVectors - start);
+            ids.resize(count);
+            data.resize(count * dim);
+            for (size_t i = 0; i < count; i++) {
+                ids[i] = start + i + 1;
+            }
+            for (auto& v : data) {
+                v = dist(rng);
+            }
+            client.insert(ids, data);
+        }
+        double loadSeconds = std::chrono::duration<double>(Clock::now() - loadStart).count();
+        std::cout << "Loaded " << client.size() << " vectors (dim=" << dim << ") over "
+                  << (useTcp ? "TCP" : "Unix socket") << " in " << loadSeconds << "s" << std::endl;
+
+        std::vector<Vector> queries(numQueries, Vector(dim));
+        for (auto& query : queries) {
+            for (auto& v : query) {
+                v = dist(rng);
+            }
+        }
+
+        // direct call, same thread (the server loop is idle meanwhile)
+        std::vector<double> micros;
+        for (const auto& query : queries) {
+            auto start = Clock::now();
+            auto results = index.search(query, k, efSearch);
+            micros.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        }
+        report("direct HNSW::search  ", micros);
+
+        // one request in flight
+        micros.clear();
+        for (const auto& query : queries) {
+            auto start = Clock::now();
+            auto results = client.search(query, k, efSearch);
+            micros.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        }
+        report("wire round trip      ", micros);
+
+        // pipelined: keep `depth` requests in flight
+        const size_t depth = 16;
+        std::vector<uint32_t> inFlight;
+        auto start = Clock::now();
+        size_t sent = 0;
+        size_t received = 0;
+        while (received < numQueries) {
+            while (sent < numQueries && inFlight.size() - received < depth) {
+                inFlight.push_back(client.sendSearch(queries[sent], dim, k, efSearch));
+                sent++;
+            }
+            client.receiveSearch(inFlight[received++]);
+        }
+        double pipelined = std::chrono::duration<double>(Clock::now() - start).count();
+        std::cout << "pipelined (depth " << depth << ") : " << numQueries / pipelined << " QPS"
+                  << std::endl;
+
+        // batched: 64 queries per frame
+        const size_t perFrame = 64;
+        std::vector<float> frame;
+        start = Clock::now();
+        for (size_t q = 0; q < numQueries; q += perFrame) {
+            frame.clear();
+            for (size_t i = q; i < std::min(q + perFrame, numQueries); i++) {
+                frame.insert(frame.end(), queries[i].begin(), queries[i].end());
+            }
+            client.searchBatch(frame, dim, k, efSearch);
+        }
+        double batched = std::chrono::duration<double>(Clock::now() - start).count();
+        std::cout << "batched (" << perFrame << "/frame)   : " << numQueries / batched << " QPS"
+                  << std::endl;
+    }
+
+    server.stop();
+    loop.join();
+    return 0;
+}